@@ -1,7 +1,22 @@
 #include "bvh.h"
+#include "../parallel/Parallel.h"
+#include <immintrin.h>
 
 RENDERING_BEGIN
 
+STAT_MEMORY_COUNTER("Memory/BVH tree", treeBytes);
+STAT_RATIO("BVH/Primitives per leaf node", totalPrimitives, totalLeafNodes);
+STAT_COUNTER("BVH/Interior nodes", interiorNodes);
+STAT_COUNTER("BVH/Leaf nodes", leafNodes);
+STAT_COUNTER("BVH/Build time (ms)", buildTimeMs);
+STAT_COUNTER("BVH/Wide nodes", wideNodes);
+STAT_MEMORY_COUNTER("Memory/BVH motion bounds", motionBoundsBytes);
+STAT_COUNTER("BVH/Intersect rays", intersectRays);
+STAT_COUNTER("BVH/Occlusion rays", occlusionRays);
+
+// 图元数量小于该值的子树作为一个并行任务构建
+static CONSTEXPR int parallelBuildThreshold = 16 * 1024;
+
 // BVHAccel Utility Functions
 inline uint32_t LeftShift3(uint32_t x) {
     CHECK_LE(x, (1 << 10));
@@ -42,6 +57,14 @@ static void RadixSort(std::vector<MortonPrimitive>* v) {
     static_assert((nBits % bitsPerPass) == 0,
         "Radix sort bitsPerPass must evenly divide nBits");
     CONSTEXPR int nPasses = nBits / bitsPerPass;
+    CONSTEXPR int nBuckets = 1 << bitsPerPass;
+    CONSTEXPR int bitMask = (1 << bitsPerPass) - 1;
+
+    // 数组按块划分，每个块的计数与写出由一个任务完成
+    CONSTEXPR int chunkSize = 16 * 1024;
+    int nChunks = std::max(1, int((v->size() + chunkSize - 1) / chunkSize));
+    // bucketCount[chunk * nBuckets + bucket]，先存计数，后存该块在每个桶中的写出位置
+    std::vector<int> bucketCount(nChunks * nBuckets);
 
     for (int pass = 0; pass < nPasses; ++pass) {
         // Perform one pass of radix sort, sorting _bitsPerPass_ bits
@@ -52,42 +75,139 @@ static void RadixSort(std::vector<MortonPrimitive>* v) {
         std::vector<MortonPrimitive>& out = (pass & 1) ? *v : tempVector;
 
         // Count number of zero bits in array for current radix sort bit
-        CONSTEXPR int nBuckets = 1 << bitsPerPass;
-        int bucketCount[nBuckets] = { 0 };
-        CONSTEXPR int bitMask = (1 << bitsPerPass) - 1;
-        for (const MortonPrimitive& mp : in) {
-            int bucket = (mp.mortonCode >> lowBit) & bitMask;
-            CHECK_GE(bucket, 0);
-            CHECK_LT(bucket, nBuckets);
-            ++bucketCount[bucket];
-        }
+        std::fill(bucketCount.begin(), bucketCount.end(), 0);
+        parallelFor([&](int64_t chunk) {
+            int* count = &bucketCount[chunk * nBuckets];
+            size_t chunkStart = chunk * chunkSize;
+            size_t chunkEnd = std::min(chunkStart + chunkSize, in.size());
+            for (size_t i = chunkStart; i < chunkEnd; ++i) {
+                int bucket = (in[i].mortonCode >> lowBit) & bitMask;
+                CHECK_GE(bucket, 0);
+                CHECK_LT(bucket, nBuckets);
+                ++count[bucket];
+            }
+        }, nChunks);
 
         // Compute starting index in output array for each bucket
-        int outIndex[nBuckets];
-        outIndex[0] = 0;
-        for (int i = 1; i < nBuckets; ++i)
-            outIndex[i] = outIndex[i - 1] + bucketCount[i - 1];
+        // 按先桶后块的顺序求前缀和，同一个桶内保持原有顺序，排序是稳定的
+        int outIndex = 0;
+        for (int bucket = 0; bucket < nBuckets; ++bucket) {
+            for (int chunk = 0; chunk < nChunks; ++chunk) {
+                int count = bucketCount[chunk * nBuckets + bucket];
+                bucketCount[chunk * nBuckets + bucket] = outIndex;
+                outIndex += count;
+            }
+        }
 
         // Store sorted values in output array
-        for (const MortonPrimitive& mp : in) {
-            int bucket = (mp.mortonCode >> lowBit) & bitMask;
-            out[outIndex[bucket]++] = mp;
-        }
+        parallelFor([&](int64_t chunk) {
+            int* outIndex = &bucketCount[chunk * nBuckets];
+            size_t chunkStart = chunk * chunkSize;
+            size_t chunkEnd = std::min(chunkStart + chunkSize, in.size());
+            for (size_t i = chunkStart; i < chunkEnd; ++i) {
+                int bucket = (in[i].mortonCode >> lowBit) & bitMask;
+                out[outIndex[bucket]++] = in[i];
+            }
+        }, nChunks);
     }
     // Copy final result from _tempVector_, if needed
     if (nPasses & 1) std::swap(*v, tempVector);
 }
 
+// 扫描各个桶，返回代价最小的分割位置，bounds为当前节点的包围盒
+static int findSAHSplitBucket(const BucketInfo* buckets, int nBuckets,
+    const AABB3f& bounds, Float* minCost) {
+    // 先从右往左累积右侧的包围盒与数量，再从左往右扫描，O(nBuckets)得到所有分割的代价
+    std::vector<Float> rightArea(nBuckets - 1);
+    std::vector<int> rightCount(nBuckets - 1);
+    AABB3f accBounds;
+    int accCount = 0;
+    for (int i = nBuckets - 1; i > 0; --i) {
+        accBounds = unionSet(accBounds, buckets[i].bounds);
+        accCount += buckets[i].count;
+        rightArea[i - 1] = accCount ? accBounds.surfaceArea() : 0;
+        rightCount[i - 1] = accCount;
+    }
+
+    accBounds = AABB3f();
+    accCount = 0;
+    int minCostSplitBucket = 0;
+    for (int i = 0; i < nBuckets - 1; ++i) {
+        accBounds = unionSet(accBounds, buckets[i].bounds);
+        accCount += buckets[i].count;
+        Float leftArea = accCount ? accBounds.surfaceArea() : 0;
+        Float cost = 0.125f + (accCount * leftArea + rightCount[i] * rightArea[i]) /
+            bounds.surfaceArea();
+        if (i == 0 || cost < *minCost) {
+            *minCost = cost;
+            minCostSplitBucket = i;
+        }
+    }
+    return minCostSplitBucket;
+}
+
+// 光线与宽节点的N个子节点包围盒求交，返回命中掩码，tEnter写入各个子节点的进入距离
+// 与AABB3::intersectP相同，离开距离乘以1 + 2 * gamma(3)保证求交的保守性
+template <int N>
+static inline int intersectChildren(const WideBVHNode<N>& node, const float org[3],
+    const float invDir[3], const int dirIsNeg[3], float tMax, float tEnter[N]) {
+    const float errScale = 1 + 2 * Rendering::gamma(3);
+#ifdef __AVX__
+    if (N == 8) {
+        __m256 t0 = _mm256_setzero_ps();
+        __m256 t1 = _mm256_set1_ps(tMax);
+        for (int a = 0; a < 3; ++a) {
+            const float* nearB = dirIsNeg[a] ? node.bMax[a] : node.bMin[a];
+            const float* farB = dirIsNeg[a] ? node.bMin[a] : node.bMax[a];
+            __m256 o = _mm256_set1_ps(org[a]);
+            __m256 inv = _mm256_set1_ps(invDir[a]);
+            __m256 tNear = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(nearB), o), inv);
+            __m256 tFar = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(farB), o), inv);
+            // 累积值放在第二个操作数，0 * inf产生的NaN会被忽略
+            t0 = _mm256_max_ps(tNear, t0);
+            t1 = _mm256_min_ps(_mm256_mul_ps(tFar, _mm256_set1_ps(errScale)), t1);
+        }
+        _mm256_storeu_ps(tEnter, t0);
+        return _mm256_movemask_ps(_mm256_cmp_ps(t0, t1, _CMP_LE_OQ));
+    }
+#endif
+    int mask = 0;
+    for (int g = 0; g < N; g += 4) {
+        __m128 t0 = _mm_setzero_ps();
+        __m128 t1 = _mm_set1_ps(tMax);
+        for (int a = 0; a < 3; ++a) {
+            const float* nearB = dirIsNeg[a] ? node.bMax[a] : node.bMin[a];
+            const float* farB = dirIsNeg[a] ? node.bMin[a] : node.bMax[a];
+            __m128 o = _mm_set1_ps(org[a]);
+            __m128 inv = _mm_set1_ps(invDir[a]);
+            __m128 tNear = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(nearB + g), o), inv);
+            __m128 tFar = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(farB + g), o), inv);
+            t0 = _mm_max_ps(tNear, t0);
+            t1 = _mm_min_ps(_mm_mul_ps(tFar, _mm_set1_ps(errScale)), t1);
+        }
+        _mm_storeu_ps(tEnter + g, t0);
+        mask |= _mm_movemask_ps(_mm_cmple_ps(t0, t1)) << g;
+    }
+    return mask;
+}
+
 AABB3f BVHAccel::worldBound() const {
-    return nodes ? nodes[0].bounds : AABB3f();
+    return bounds;
 }
 
 
 BVHAccel::BVHAccel(std::vector<std::shared_ptr<Primitive>> p,
-    int maxPrimsInNode, SplitMethod splitMethod)
+    int maxPrimsInNode, SplitMethod splitMethod, NodeLayout layout,
+    int motionSegments, Float shutterOpen, Float shutterClose)
     : maxPrimsInNode(std::min(255, maxPrimsInNode)),
     splitMethod(splitMethod),
-    primitives(std::move(p)) {
+    layout(motionSegments > 0 ? NodeLayout::Binary : layout),
+    primitives(std::move(p)),
+    motionSegments(std::max(0, motionSegments)),
+    shutterOpen(shutterOpen),
+    shutterClose(shutterClose) {
+    ProfilePhase _(Prof::AccelConstruction);
+    auto startTime = std::chrono::steady_clock::now();
 
     if (primitives.empty()) return;
 
@@ -96,39 +216,314 @@ BVHAccel::BVHAccel(std::vector<std::shared_ptr<Primitive>> p,
     for (size_t i = 0; i < primitives.size(); ++i)
         primitiveInfo[i] = { i, primitives[i]->worldBound() };
 
-    MemoryArena arena(1024 * 1024);
+    // 每个线程各自持有一个arena，并行构建子树时无需加锁
+    std::vector<MemoryArena> arenas(maxThreadIndex());
     int totalNodes = 0;
-    std::vector<std::shared_ptr<Primitive>> orderedPrims;
-    orderedPrims.reserve(primitives.size());
+    // orderedPrims按下标写入，子树可以并行构建而不依赖构建顺序
+    std::vector<std::shared_ptr<Primitive>> orderedPrims(primitives.size());
     BVHBuildNode *root;
     if (splitMethod == SplitMethod::HLBVH)
-        root = HLBVHBuild(arena, primitiveInfo, &totalNodes, orderedPrims);
-    else
-        root = recursiveBuild(arena, primitiveInfo, 0, primitives.size(),
-            &totalNodes, orderedPrims);
+        root = HLBVHBuild(arenas[0], primitiveInfo, &totalNodes, orderedPrims);
+    else {
+        // 先串行划分顶层，图元数量小于阈值的子树留待并行构建
+        std::vector<BVHBuildTask> buildTasks;
+        root = recursiveBuild(arenas, primitiveInfo, 0, primitives.size(),
+            &totalNodes, orderedPrims, &buildTasks);
+        parallelFor([&](int64_t i) {
+            BVHBuildTask& task = buildTasks[i];
+            BVHBuildNode* subtree = recursiveBuild(arenas, primitiveInfo,
+                task.start, task.end, &task.totalNodes, orderedPrims);
+            *task.node = *subtree;
+        }, buildTasks.size());
+        // 子树的根节点已在顶层计数过一次
+        for (const BVHBuildTask& task : buildTasks)
+            totalNodes += task.totalNodes - 1;
+    }
     primitives.swap(orderedPrims);
     primitiveInfo.resize(0);
-    
-    nodes = allocAligned<LinearBVHNode>(totalNodes);
+
+    bounds = root->bounds;
+
     int offset = 0;
-    flattenBVHTree(root, &offset);
-    CHECK_EQ(totalNodes, offset);
+    if (this->layout == NodeLayout::Binary) {
+        // Compute representation of depth-first traversal of BVH tree
+        treeBytes += totalNodes * sizeof(LinearBVHNode);
+        nodes = allocAligned<LinearBVHNode>(totalNodes);
+        flattenBVHTree(root, &offset);
+        CHECK_EQ(totalNodes, offset);
+
+        if (this->motionSegments > 0) {
+            // 树的划分仍按整个快门时间的包围盒进行，这里只额外计算各分段端点的包围盒
+            int nKeys = this->motionSegments + 1;
+            std::vector<AABB3f> primMotionBounds(primitives.size() * nKeys);
+            parallelFor([&](int64_t i) {
+                AABB3f* keys = &primMotionBounds[i * nKeys];
+                for (int k = 0; k < this->motionSegments; ++k) {
+                    Float time0 = lerp(Float(k) / this->motionSegments, shutterOpen, shutterClose);
+                    Float time1 = lerp(Float(k + 1) / this->motionSegments, shutterOpen, shutterClose);
+                    AABB3f b0, b1;
+                    primitives[i]->motionBounds(time0, time1, &b0, &b1);
+                    // 相邻两段共用端点，端点取两段的并集
+                    keys[k] = unionSet(keys[k], b0);
+                    keys[k + 1] = unionSet(keys[k + 1], b1);
+                }
+            }, primitives.size(), 1024);
+            motionBounds = allocAligned<AABB3f>(totalNodes * nKeys);
+            computeMotionBounds(0, primMotionBounds.data());
+            motionBoundsBytes += totalNodes * nKeys * sizeof(AABB3f);
+        }
+    } else {
+        // 二叉树中每个内部节点至多产生一个宽节点
+        int maxWideNodes = std::max(1, (totalNodes - 1) / 2);
+        if (layout == NodeLayout::BVH4) {
+            nodes4 = allocAligned<WideBVHNode<4>>(maxWideNodes);
+            collapseWideBVH(root, nodes4, &offset);
+            treeBytes += offset * sizeof(WideBVHNode<4>);
+        } else {
+            nodes8 = allocAligned<WideBVHNode<8>>(maxWideNodes);
+            collapseWideBVH(root, nodes8, &offset);
+            treeBytes += offset * sizeof(WideBVHNode<8>);
+        }
+        CHECK_LE(offset, maxWideNodes);
+        wideNodes += offset;
+    }
+    treeBytes += sizeof(*this) + primitives.size() * sizeof(primitives[0]);
+
+    buildTimeMs += std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime).count();
 }
 
-BVHAccel::~BVHAccel() {}
+BVHAccel::~BVHAccel() {
+    freeAligned(motionBounds);
+    freeAligned(nodes);
+    freeAligned(nodes4);
+    freeAligned(nodes8);
+}
 
 BVHBuildNode* BVHAccel::recursiveBuild(
-    MemoryArena& arena, std::vector<BVHPrimitiveInfo>& primitiveInfo,
+    std::vector<MemoryArena>& arenas, std::vector<BVHPrimitiveInfo>& primitiveInfo,
     int start, int end, int* totalNodes,
-    std::vector<std::shared_ptr<Primitive>>& orderedPrims) {
-    return nullptr;
+    std::vector<std::shared_ptr<Primitive>>& orderedPrims,
+    std::vector<BVHBuildTask>* buildTasks) const {
+    CHECK_NE(start, end);
+    // 每个线程同一时刻只执行一个构建任务，按线程索引取arena无需加锁
+    BVHBuildNode* node = ARENA_ALLOC(arenas[ThreadIndex], BVHBuildNode);
+    (*totalNodes)++;
+
+    // Compute bounds of all primitives in BVH node
+    AABB3f bounds;
+    for (int i = start; i < end; ++i)
+        bounds = unionSet(bounds, primitiveInfo[i].bounds);
+    int nPrimitives = end - start;
+
+    if (buildTasks && nPrimitives < parallelBuildThreshold) {
+        // 只记录包围盒，子树构建完成后覆盖该节点
+        node->bounds = bounds;
+        buildTasks->push_back({ node, start, end, 0 });
+        return node;
+    }
+
+    auto createLeaf = [&]() {
+        // Create leaf _BVHBuildNode_
+        for (int i = start; i < end; ++i) {
+            int primNum = primitiveInfo[i].primitiveNumber;
+            orderedPrims[i] = primitives[primNum];
+        }
+        node->InitLeaf(start, nPrimitives, bounds);
+        ++leafNodes;
+        ++totalLeafNodes;
+        totalPrimitives += nPrimitives;
+        return node;
+    };
+
+    if (nPrimitives == 1) {
+        return createLeaf();
+    }
+
+    // Compute bound of primitive centroids, choose split dimension _dim_
+    AABB3f centroidBounds;
+    for (int i = start; i < end; ++i)
+        centroidBounds = unionSet(centroidBounds, primitiveInfo[i].centroid);
+    int dim = centroidBounds.maximumExtent();
+
+    // Partition primitives into two sets and build children
+    int mid = (start + end) / 2;
+    if (centroidBounds.pMax[dim] == centroidBounds.pMin[dim]) {
+        // 所有质心重合，无法继续划分
+        if (nPrimitives <= maxPrimsInNode) {
+            return createLeaf();
+        }
+        // 图元数量超过叶子上限时按数量对半分，保证nPrimitives不溢出uint16_t
+    } else {
+        // Partition primitives based on _splitMethod_
+        switch (splitMethod) {
+        case SplitMethod::Middle: {
+            // Partition primitives through node's midpoint
+            Float pmid = (centroidBounds.pMin[dim] + centroidBounds.pMax[dim]) / 2;
+            BVHPrimitiveInfo* midPtr = std::partition(
+                &primitiveInfo[start], &primitiveInfo[end - 1] + 1,
+                [dim, pmid](const BVHPrimitiveInfo& pi) {
+                    return pi.centroid[dim] < pmid;
+                });
+            mid = midPtr - &primitiveInfo[0];
+            // For lots of prims with large overlapping bounding boxes, this
+            // may fail to partition; in that case don't break and fall
+            // through to EqualCounts.
+            if (mid != start && mid != end) break;
+        }
+        case SplitMethod::EqualCounts: {
+            // Partition primitives into equally-sized subsets
+            mid = (start + end) / 2;
+            std::nth_element(&primitiveInfo[start], &primitiveInfo[mid],
+                &primitiveInfo[end - 1] + 1,
+                [dim](const BVHPrimitiveInfo& a, const BVHPrimitiveInfo& b) {
+                    return a.centroid[dim] < b.centroid[dim];
+                });
+            break;
+        }
+        case SplitMethod::SAH:
+        default: {
+            // Partition primitives using approximate SAH
+            if (nPrimitives <= 2) {
+                // Partition primitives into equally-sized subsets
+                mid = (start + end) / 2;
+                std::nth_element(&primitiveInfo[start], &primitiveInfo[mid],
+                    &primitiveInfo[end - 1] + 1,
+                    [dim](const BVHPrimitiveInfo& a, const BVHPrimitiveInfo& b) {
+                        return a.centroid[dim] < b.centroid[dim];
+                    });
+                break;
+            }
+
+            // Allocate _BucketInfo_ for SAH partition buckets
+            CONSTEXPR int nBuckets = 12;
+            BucketInfo buckets[nBuckets];
+
+            // Initialize _BucketInfo_ for SAH partition buckets
+            for (int i = start; i < end; ++i) {
+                int b = nBuckets * centroidBounds.offset(primitiveInfo[i].centroid)[dim];
+                if (b == nBuckets) b = nBuckets - 1;
+                CHECK_GE(b, 0);
+                CHECK_LT(b, nBuckets);
+                buckets[b].count++;
+                buckets[b].bounds = unionSet(buckets[b].bounds, primitiveInfo[i].bounds);
+            }
+
+            // Find bucket to split at that minimizes SAH metric
+            Float minCost;
+            int minCostSplitBucket = findSAHSplitBucket(buckets, nBuckets, bounds, &minCost);
+
+            // Either create leaf or split primitives at selected SAH bucket
+            Float leafCost = nPrimitives;
+            if (nPrimitives > maxPrimsInNode || minCost < leafCost) {
+                BVHPrimitiveInfo* pmid = std::partition(
+                    &primitiveInfo[start], &primitiveInfo[end - 1] + 1,
+                    [=](const BVHPrimitiveInfo& pi) {
+                        int b = nBuckets * centroidBounds.offset(pi.centroid)[dim];
+                        if (b == nBuckets) b = nBuckets - 1;
+                        CHECK_GE(b, 0);
+                        CHECK_LT(b, nBuckets);
+                        return b <= minCostSplitBucket;
+                    });
+                mid = pmid - &primitiveInfo[0];
+            } else {
+                return createLeaf();
+            }
+            break;
+        }
+        }
+    }
+
+    if (mid == start || mid == end) {
+        // 浮点误差导致划分失败时，退化为按数量对半分
+        mid = (start + end) / 2;
+        std::nth_element(&primitiveInfo[start], &primitiveInfo[mid],
+            &primitiveInfo[end - 1] + 1,
+            [dim](const BVHPrimitiveInfo& a, const BVHPrimitiveInfo& b) {
+                return a.centroid[dim] < b.centroid[dim];
+            });
+    }
+
+    node->initInterior(dim,
+        recursiveBuild(arenas, primitiveInfo, start, mid,
+            totalNodes, orderedPrims, buildTasks),
+        recursiveBuild(arenas, primitiveInfo, mid, end,
+            totalNodes, orderedPrims, buildTasks));
+    ++interiorNodes;
+    return node;
 }
 
 BVHBuildNode* BVHAccel::HLBVHBuild(
     MemoryArena& arena, const std::vector<BVHPrimitiveInfo>& primitiveInfo,
     int* totalNodes,
     std::vector<std::shared_ptr<Primitive>>& orderedPrims) const {
-    return nullptr;
+    // Compute bounding box of all primitive centroids
+    AABB3f bounds;
+    for (const BVHPrimitiveInfo& pi : primitiveInfo)
+        bounds = unionSet(bounds, pi.centroid);
+
+    // Compute Morton indices of primitives
+    std::vector<MortonPrimitive> mortonPrims(primitiveInfo.size());
+    parallelFor([&](int64_t i) {
+        // Initialize _mortonPrims[i]_ for _i_th primitive
+        // 质心在包围盒中的相对位置量化到10位，三个维度交错成30位的morton码
+        CONSTEXPR int mortonBits = 10;
+        CONSTEXPR int mortonScale = 1 << mortonBits;
+        mortonPrims[i].primitiveIndex = primitiveInfo[i].primitiveNumber;
+        Vector3f centroidOffset = bounds.offset(primitiveInfo[i].centroid);
+        mortonPrims[i].mortonCode = EncodeMorton3(centroidOffset * mortonScale);
+    }, primitiveInfo.size(), 512);
+
+    // Radix sort primitive Morton indices
+    RadixSort(&mortonPrims);
+
+    // Create LBVH treelets at bottom of BVH
+
+    // Find intervals of primitives for each treelet
+    // 高12位相同的图元划分到同一个treelet中
+    std::vector<LBVHTreelet> treeletsToBuild;
+    for (int start = 0, end = 1; end <= (int)mortonPrims.size(); ++end) {
+#ifdef PBRT_HAVE_BINARY_CONSTANTS
+        uint32_t mask = 0b00111111111111000000000000000000;
+#else
+        uint32_t mask = 0x3ffc0000;
+#endif
+        if (end == (int)mortonPrims.size() ||
+            ((mortonPrims[start].mortonCode & mask) !=
+                (mortonPrims[end].mortonCode & mask))) {
+            // Add entry to _treeletsToBuild_ for this treelet
+            // 节点在这里预先分配好，各个treelet并行构建时不需要访问arena
+            int nPrimitives = end - start;
+            int maxBVHNodes = 2 * nPrimitives;
+            BVHBuildNode* nodes = arena.alloc<BVHBuildNode>(maxBVHNodes, false);
+            treeletsToBuild.push_back({ start, nPrimitives, nodes });
+            start = end;
+        }
+    }
+
+    // Create LBVHs for treelets in parallel
+    std::atomic<int> atomicTotal(0), orderedPrimsOffset(0);
+    orderedPrims.resize(primitives.size());
+    parallelFor([&](int64_t i) {
+        // Generate _i_th LBVH treelet
+        int nodesCreated = 0;
+        const int firstBitIndex = 29 - 12;
+        LBVHTreelet& tr = treeletsToBuild[i];
+        tr.buildNodes =
+            emitLBVH(tr.buildNodes, primitiveInfo, &mortonPrims[tr.startIndex],
+                tr.nPrimitives, &nodesCreated, orderedPrims,
+                &orderedPrimsOffset, firstBitIndex);
+        atomicTotal += nodesCreated;
+    }, treeletsToBuild.size());
+    *totalNodes = atomicTotal;
+
+    // Create and return SAH BVH from LBVH treelets
+    std::vector<BVHBuildNode*> finishedTreelets;
+    finishedTreelets.reserve(treeletsToBuild.size());
+    for (LBVHTreelet& treelet : treeletsToBuild)
+        finishedTreelets.push_back(treelet.buildNodes);
+    return buildUpperSAH(arena, finishedTreelets, 0, finishedTreelets.size(),
+        totalNodes);
 }
 
 BVHBuildNode* BVHAccel::emitLBVH(
@@ -137,24 +532,458 @@ BVHBuildNode* BVHAccel::emitLBVH(
     MortonPrimitive* mortonPrims, int nPrimitives, int* totalNodes,
     std::vector<std::shared_ptr<Primitive>>& orderedPrims,
     std::atomic<int>* orderedPrimsOffset, int bitIndex) const {
-    return nullptr;
+    CHECK_GT(nPrimitives, 0);
+    if (bitIndex == -1 || nPrimitives < maxPrimsInNode) {
+        // Create and return leaf node of LBVH treelet
+        (*totalNodes)++;
+        BVHBuildNode* node = buildNodes++;
+        AABB3f bounds;
+        int firstPrimOffset = orderedPrimsOffset->fetch_add(nPrimitives);
+        for (int i = 0; i < nPrimitives; ++i) {
+            int primitiveIndex = mortonPrims[i].primitiveIndex;
+            orderedPrims[firstPrimOffset + i] = primitives[primitiveIndex];
+            bounds = unionSet(bounds, primitiveInfo[primitiveIndex].bounds);
+        }
+        node->InitLeaf(firstPrimOffset, nPrimitives, bounds);
+        ++leafNodes;
+        ++totalLeafNodes;
+        totalPrimitives += nPrimitives;
+        return node;
+    } else {
+        int mask = 1 << bitIndex;
+        // Advance to next subtree level if there's no LBVH split for this bit
+        if ((mortonPrims[0].mortonCode & mask) ==
+            (mortonPrims[nPrimitives - 1].mortonCode & mask))
+            return emitLBVH(buildNodes, primitiveInfo, mortonPrims, nPrimitives,
+                totalNodes, orderedPrims, orderedPrimsOffset,
+                bitIndex - 1);
+
+        // Find LBVH split point for this dimension
+        // morton码已排序，二分查找当前位由0变为1的位置
+        int searchStart = 0, searchEnd = nPrimitives - 1;
+        while (searchStart + 1 != searchEnd) {
+            CHECK_NE(searchStart, searchEnd);
+            int mid = (searchStart + searchEnd) / 2;
+            if ((mortonPrims[searchStart].mortonCode & mask) ==
+                (mortonPrims[mid].mortonCode & mask))
+                searchStart = mid;
+            else {
+                CHECK_EQ(mortonPrims[mid].mortonCode & mask,
+                    mortonPrims[searchEnd].mortonCode & mask);
+                searchEnd = mid;
+            }
+        }
+        int splitOffset = searchEnd;
+        CHECK_LE(splitOffset, nPrimitives - 1);
+        CHECK_NE(mortonPrims[splitOffset - 1].mortonCode & mask,
+            mortonPrims[splitOffset].mortonCode & mask);
+
+        // Create and return interior LBVH node
+        (*totalNodes)++;
+        BVHBuildNode* node = buildNodes++;
+        BVHBuildNode* lbvh[2] = {
+            emitLBVH(buildNodes, primitiveInfo, mortonPrims, splitOffset,
+                totalNodes, orderedPrims, orderedPrimsOffset,
+                bitIndex - 1),
+            emitLBVH(buildNodes, primitiveInfo, &mortonPrims[splitOffset],
+                nPrimitives - splitOffset, totalNodes, orderedPrims,
+                orderedPrimsOffset, bitIndex - 1) };
+        int axis = bitIndex % 3;
+        node->initInterior(axis, lbvh[0], lbvh[1]);
+        ++interiorNodes;
+        return node;
+    }
 }
 
 BVHBuildNode* BVHAccel::buildUpperSAH(MemoryArena& arena,
     std::vector<BVHBuildNode*>& treeletRoots,
     int start, int end, int* totalNodes) const {
-    return nullptr;
+    CHECK_LT(start, end);
+    int nNodes = end - start;
+    if (nNodes == 1) return treeletRoots[start];
+    (*totalNodes)++;
+    BVHBuildNode* node = ARENA_ALLOC(arena, BVHBuildNode);
+
+    // Compute bounds of all nodes under this HLBVH node
+    AABB3f bounds;
+    for (int i = start; i < end; ++i)
+        bounds = unionSet(bounds, treeletRoots[i]->bounds);
+
+    // Compute bound of HLBVH node centroids, choose split dimension _dim_
+    AABB3f centroidBounds;
+    for (int i = start; i < end; ++i) {
+        Point3f centroid =
+            (treeletRoots[i]->bounds.pMin + treeletRoots[i]->bounds.pMax) *
+            0.5f;
+        centroidBounds = unionSet(centroidBounds, centroid);
+    }
+    int dim = centroidBounds.maximumExtent();
+
+    int mid = (start + end) / 2;
+    if (centroidBounds.pMax[dim] != centroidBounds.pMin[dim]) {
+        // Allocate _BucketInfo_ for SAH partition buckets
+        CONSTEXPR int nBuckets = 12;
+        BucketInfo buckets[nBuckets];
+
+        // Initialize _BucketInfo_ for HLBVH SAH partition buckets
+        for (int i = start; i < end; ++i) {
+            Float centroid = (treeletRoots[i]->bounds.pMin[dim] +
+                treeletRoots[i]->bounds.pMax[dim]) *
+                0.5f;
+            int b =
+                nBuckets * ((centroid - centroidBounds.pMin[dim]) /
+                    (centroidBounds.pMax[dim] - centroidBounds.pMin[dim]));
+            if (b == nBuckets) b = nBuckets - 1;
+            CHECK_GE(b, 0);
+            CHECK_LT(b, nBuckets);
+            buckets[b].count++;
+            buckets[b].bounds = unionSet(buckets[b].bounds, treeletRoots[i]->bounds);
+        }
+
+        // Find bucket to split at that minimizes SAH metric
+        Float minCost;
+        int minCostSplitBucket = findSAHSplitBucket(buckets, nBuckets, bounds, &minCost);
+
+        // Split nodes and create interior HLBVH SAH node
+        BVHBuildNode** pmid = std::partition(
+            &treeletRoots[start], &treeletRoots[end - 1] + 1,
+            [=](const BVHBuildNode* node) {
+                Float centroid =
+                    (node->bounds.pMin[dim] + node->bounds.pMax[dim]) * 0.5f;
+                int b = nBuckets *
+                    ((centroid - centroidBounds.pMin[dim]) /
+                        (centroidBounds.pMax[dim] - centroidBounds.pMin[dim]));
+                if (b == nBuckets) b = nBuckets - 1;
+                CHECK_GE(b, 0);
+                CHECK_LT(b, nBuckets);
+                return b <= minCostSplitBucket;
+            });
+        mid = pmid - &treeletRoots[0];
+    }
+    if (mid == start || mid == end) {
+        // treelet的质心重合或划分失败时，按数量对半分
+        mid = (start + end) / 2;
+    }
+    CHECK_GT(mid, start);
+    CHECK_LT(mid, end);
+    node->initInterior(
+        dim, this->buildUpperSAH(arena, treeletRoots, start, mid, totalNodes),
+        this->buildUpperSAH(arena, treeletRoots, mid, end, totalNodes));
+    ++interiorNodes;
+    return node;
 }
 
 int BVHAccel::flattenBVHTree(BVHBuildNode* node, int* offset) {
-    return 1;
+    LinearBVHNode* linearNode = &nodes[*offset];
+    linearNode->bounds = node->bounds;
+    int myOffset = (*offset)++;
+    if (node->nPrimitives > 0) {
+        DCHECK(!node->children[0] && !node->children[1]);
+        CHECK_LT(node->nPrimitives, 65536);
+        linearNode->primitivesOffset = node->firstPrimOffset;
+        linearNode->nPrimitives = node->nPrimitives;
+    } else {
+        // Create interior flattened BVH node
+        // 第一个子节点紧跟在父节点之后，只需记录第二个子节点的偏移量
+        linearNode->axis = node->splitAxis;
+        linearNode->nPrimitives = 0;
+        flattenBVHTree(node->children[0], offset);
+        linearNode->secondChildOffset =
+            flattenBVHTree(node->children[1], offset);
+    }
+    return myOffset;
+}
+
+void BVHAccel::computeMotionBounds(int nodeIndex, const AABB3f* primMotionBounds) {
+    const LinearBVHNode* node = &nodes[nodeIndex];
+    int nKeys = motionSegments + 1;
+    AABB3f* keys = &motionBounds[nodeIndex * nKeys];
+    for (int k = 0; k < nKeys; ++k)
+        keys[k] = AABB3f();
+    if (node->nPrimitives > 0) {
+        for (int i = 0; i < node->nPrimitives; ++i) {
+            const AABB3f* primKeys = &primMotionBounds[(node->primitivesOffset + i) * nKeys];
+            for (int k = 0; k < nKeys; ++k)
+                keys[k] = unionSet(keys[k], primKeys[k]);
+        }
+    } else {
+        // 插值是线性的，子节点端点包围盒的并集插值后仍能包住两个子节点
+        computeMotionBounds(nodeIndex + 1, primMotionBounds);
+        computeMotionBounds(node->secondChildOffset, primMotionBounds);
+        const AABB3f* keys0 = &motionBounds[(nodeIndex + 1) * nKeys];
+        const AABB3f* keys1 = &motionBounds[node->secondChildOffset * nKeys];
+        for (int k = 0; k < nKeys; ++k)
+            keys[k] = unionSet(keys0[k], keys1[k]);
+    }
+}
+
+void BVHAccel::motionSegment(const Ray& ray, int* segment, Float* t) const {
+    Float duration = shutterClose - shutterOpen;
+    Float u = duration > 0 ? clamp((ray.time - shutterOpen) / duration, 0, 1) : 0;
+    u *= motionSegments;
+    *segment = std::min(int(u), motionSegments - 1);
+    *t = u - *segment;
+}
+
+inline bool BVHAccel::intersectNode(int nodeIndex, const Ray& ray, int segment, Float t,
+    const Vector3f& invDir, const int dirIsNeg[3]) const {
+    if (!motionBounds)
+        return nodes[nodeIndex].bounds.intersectP(ray, invDir, dirIsNeg);
+    // 用光线时间所在分段两端的包围盒插值，只插值slab测试用到的面
+    const AABB3f* keys = &motionBounds[nodeIndex * (motionSegments + 1) + segment];
+    Float tMin = (lerp(t, keys[0][dirIsNeg[0]].x, keys[1][dirIsNeg[0]].x) - ray.ori.x) * invDir.x;
+    Float tMax = (lerp(t, keys[0][1 - dirIsNeg[0]].x, keys[1][1 - dirIsNeg[0]].x) - ray.ori.x) * invDir.x;
+    Float tyMin = (lerp(t, keys[0][dirIsNeg[1]].y, keys[1][dirIsNeg[1]].y) - ray.ori.y) * invDir.y;
+    Float tyMax = (lerp(t, keys[0][1 - dirIsNeg[1]].y, keys[1][1 - dirIsNeg[1]].y) - ray.ori.y) * invDir.y;
+    tMax *= 1 + 2 * gamma(3);
+    tyMax *= 1 + 2 * gamma(3);
+    if (tMin > tyMax || tyMin > tMax) return false;
+    if (tyMin > tMin) tMin = tyMin;
+    if (tyMax < tMax) tMax = tyMax;
+    Float tzMin = (lerp(t, keys[0][dirIsNeg[2]].z, keys[1][dirIsNeg[2]].z) - ray.ori.z) * invDir.z;
+    Float tzMax = (lerp(t, keys[0][1 - dirIsNeg[2]].z, keys[1][1 - dirIsNeg[2]].z) - ray.ori.z) * invDir.z;
+    tzMax *= 1 + 2 * gamma(3);
+    if (tMin > tzMax || tzMin > tMax) return false;
+    if (tzMin > tMin) tMin = tzMin;
+    if (tzMax < tMax) tMax = tzMax;
+    return (tMin < ray.tMax) && (tMax > 0);
 }
 
-bool BVHAccel::intersect(const Ray& r, SurfaceInteraction*) const {
+bool BVHAccel::intersect(const Ray& ray, SurfaceInteraction* isect) const {
+    ++intersectRays;
+    if (nodes4) return intersectWide(nodes4, ray, isect);
+    if (nodes8) return intersectWide(nodes8, ray, isect);
+    if (!nodes) return false;
+    ProfilePhase p(Prof::AccelRayIntersect);
+    bool hit = false;
+    // 每条光线只计算一次方向的倒数与符号，所有节点共用
+    Vector3f invDir(1 / ray.dir.x, 1 / ray.dir.y, 1 / ray.dir.z);
+    int dirIsNeg[3] = { invDir.x < 0, invDir.y < 0, invDir.z < 0 };
+    int segment = 0;
+    Float t = 0;
+    if (motionBounds) motionSegment(ray, &segment, &t);
+    // Follow ray through BVH nodes to find primitive intersections
+    int toVisitOffset = 0, currentNodeIndex = 0;
+    int nodesToVisit[64];
+    while (true) {
+        const LinearBVHNode* node = &nodes[currentNodeIndex];
+        // Check ray against BVH node
+        if (intersectNode(currentNodeIndex, ray, segment, t, invDir, dirIsNeg)) {
+            if (node->nPrimitives > 0) {
+                // Intersect ray with primitives in leaf BVH node
+                // 求交成功时primitive会缩短ray.tMax
+                for (int i = 0; i < node->nPrimitives; ++i)
+                    if (primitives[node->primitivesOffset + i]->intersect(ray, isect))
+                        hit = true;
+                if (toVisitOffset == 0) break;
+                currentNodeIndex = nodesToVisit[--toVisitOffset];
+            } else {
+                // Put far BVH node on _nodesToVisit_ stack, advance to near
+                // node
+                if (dirIsNeg[node->axis]) {
+                    nodesToVisit[toVisitOffset++] = currentNodeIndex + 1;
+                    currentNodeIndex = node->secondChildOffset;
+                } else {
+                    nodesToVisit[toVisitOffset++] = node->secondChildOffset;
+                    currentNodeIndex = currentNodeIndex + 1;
+                }
+            }
+        } else {
+            if (toVisitOffset == 0) break;
+            currentNodeIndex = nodesToVisit[--toVisitOffset];
+        }
+    }
+    return hit;
+}
+
+bool BVHAccel::intersectP(const Ray& ray) const {
+    ++occlusionRays;
+    if (nodes4) return intersectPWide(nodes4, ray);
+    if (nodes8) return intersectPWide(nodes8, ray);
+    if (!nodes) return false;
+    ProfilePhase p(Prof::AccelRayOccluded);
+    Vector3f invDir(1.f / ray.dir.x, 1.f / ray.dir.y, 1.f / ray.dir.z);
+    int dirIsNeg[3] = { invDir.x < 0, invDir.y < 0, invDir.z < 0 };
+    int segment = 0;
+    Float t = 0;
+    if (motionBounds) motionSegment(ray, &segment, &t);
+    int nodesToVisit[64];
+    int toVisitOffset = 0, currentNodeIndex = 0;
+    while (true) {
+        const LinearBVHNode* node = &nodes[currentNodeIndex];
+        if (intersectNode(currentNodeIndex, ray, segment, t, invDir, dirIsNeg)) {
+            // Process BVH node _node_ for traversal
+            if (node->nPrimitives > 0) {
+                // 只需判断是否被遮挡，找到任意交点即可返回
+                for (int i = 0; i < node->nPrimitives; ++i) {
+                    if (primitives[node->primitivesOffset + i]->intersectP(ray)) {
+                        return true;
+                    }
+                }
+                if (toVisitOffset == 0) break;
+                currentNodeIndex = nodesToVisit[--toVisitOffset];
+            } else {
+                if (dirIsNeg[node->axis]) {
+                    // second child first
+                    nodesToVisit[toVisitOffset++] = currentNodeIndex + 1;
+                    currentNodeIndex = node->secondChildOffset;
+                } else {
+                    nodesToVisit[toVisitOffset++] = node->secondChildOffset;
+                    currentNodeIndex = currentNodeIndex + 1;
+                }
+            }
+        } else {
+            if (toVisitOffset == 0) break;
+            currentNodeIndex = nodesToVisit[--toVisitOffset];
+        }
+    }
     return false;
 }
 
-bool BVHAccel::intersectP(const Ray& r) const {
+template <int N>
+int BVHAccel::collapseWideBVH(BVHBuildNode* node, WideBVHNode<N>* wideNodes,
+    int* offset) const {
+    WideBVHNode<N>* wideNode = &wideNodes[*offset];
+    int myOffset = (*offset)++;
+
+    // Gather up to _N_ children, always opening the interior child with the
+    // largest surface area
+    BVHBuildNode* children[N];
+    int nChildren = 0;
+    if (node->nPrimitives > 0) {
+        // 只有根节点可能是叶子
+        children[nChildren++] = node;
+    } else {
+        children[nChildren++] = node->children[0];
+        children[nChildren++] = node->children[1];
+        while (nChildren < N) {
+            int best = -1;
+            Float bestArea = -1;
+            for (int i = 0; i < nChildren; ++i) {
+                if (children[i]->nPrimitives == 0 &&
+                    children[i]->bounds.surfaceArea() > bestArea) {
+                    best = i;
+                    bestArea = children[i]->bounds.surfaceArea();
+                }
+            }
+            if (best == -1) break;
+            BVHBuildNode* opened = children[best];
+            children[best] = opened->children[0];
+            children[nChildren++] = opened->children[1];
+        }
+    }
+
+    // 空槽的包围盒取反，任何光线都不会与之相交
+    for (int i = 0; i < N; ++i) {
+        for (int a = 0; a < 3; ++a) {
+            wideNode->bMin[a][i] = i < nChildren ? float(children[i]->bounds.pMin[a]) : Infinity;
+            wideNode->bMax[a][i] = i < nChildren ? float(children[i]->bounds.pMax[a]) : -Infinity;
+        }
+        wideNode->child[i] = -1;
+        wideNode->nPrimitives[i] = 0;
+    }
+    for (int i = 0; i < nChildren; ++i) {
+        if (children[i]->nPrimitives > 0) {
+            CHECK_LT(children[i]->nPrimitives, 65536);
+            wideNode->child[i] = children[i]->firstPrimOffset;
+            wideNode->nPrimitives[i] = children[i]->nPrimitives;
+        } else {
+            wideNode->child[i] = collapseWideBVH(children[i], wideNodes, offset);
+        }
+    }
+    return myOffset;
+}
+
+template <int N>
+bool BVHAccel::intersectWide(const WideBVHNode<N>* wideNodes, const Ray& ray,
+    SurfaceInteraction* isect) const {
+    ProfilePhase p(Prof::AccelRayIntersect);
+    bool hit = false;
+    float org[3] = { float(ray.ori.x), float(ray.ori.y), float(ray.ori.z) };
+    float invDir[3] = { float(1 / ray.dir.x), float(1 / ray.dir.y), float(1 / ray.dir.z) };
+    int dirIsNeg[3] = { invDir[0] < 0, invDir[1] < 0, invDir[2] < 0 };
+
+    // 待访问的子节点与其进入距离，出栈时进入距离已超过ray.tMax的直接跳过
+    struct StackEntry {
+        int32_t child;
+        uint16_t nPrimitives;
+        float tEnter;
+    };
+    StackEntry stack[64 * N];
+    int stackSize = 0;
+    int currentNodeIndex = 0;
+    while (true) {
+        const WideBVHNode<N>& node = wideNodes[currentNodeIndex];
+        float tEnter[N];
+        int mask = intersectChildren<N>(node, org, invDir, dirIsNeg,
+            float(ray.tMax), tEnter);
+
+        // Sort hit children by distance, nearest first
+        int order[N];
+        int nHits = 0;
+        for (int i = 0; i < N; ++i) {
+            if (!(mask & (1 << i))) continue;
+            int j = nHits++;
+            while (j > 0 && tEnter[order[j - 1]] > tEnter[i]) {
+                order[j] = order[j - 1];
+                --j;
+            }
+            order[j] = i;
+        }
+        // 由远到近压栈，最近的子节点最先出栈
+        for (int k = nHits - 1; k >= 0; --k) {
+            int i = order[k];
+            stack[stackSize++] = { node.child[i], node.nPrimitives[i], tEnter[i] };
+        }
+
+        currentNodeIndex = -1;
+        while (stackSize > 0) {
+            const StackEntry& entry = stack[--stackSize];
+            if (entry.tEnter > ray.tMax) continue;
+            if (entry.nPrimitives > 0) {
+                // Intersect ray with primitives in leaf
+                for (int i = 0; i < entry.nPrimitives; ++i)
+                    if (primitives[entry.child + i]->intersect(ray, isect))
+                        hit = true;
+            } else {
+                currentNodeIndex = entry.child;
+                break;
+            }
+        }
+        if (currentNodeIndex < 0) break;
+    }
+    return hit;
+}
+
+template <int N>
+bool BVHAccel::intersectPWide(const WideBVHNode<N>* wideNodes, const Ray& ray) const {
+    ProfilePhase p(Prof::AccelRayOccluded);
+    float org[3] = { float(ray.ori.x), float(ray.ori.y), float(ray.ori.z) };
+    float invDir[3] = { float(1 / ray.dir.x), float(1 / ray.dir.y), float(1 / ray.dir.z) };
+    int dirIsNeg[3] = { invDir[0] < 0, invDir[1] < 0, invDir[2] < 0 };
+
+    // 只需判断是否被遮挡，子节点无需排序
+    int nodesToVisit[64 * N];
+    int toVisitOffset = 0;
+    int currentNodeIndex = 0;
+    while (true) {
+        const WideBVHNode<N>& node = wideNodes[currentNodeIndex];
+        float tEnter[N];
+        int mask = intersectChildren<N>(node, org, invDir, dirIsNeg,
+            float(ray.tMax), tEnter);
+        for (int i = 0; i < N; ++i) {
+            if (!(mask & (1 << i))) continue;
+            if (node.nPrimitives[i] > 0) {
+                for (int j = 0; j < node.nPrimitives[i]; ++j)
+                    if (primitives[node.child[i] + j]->intersectP(ray))
+                        return true;
+            } else {
+                nodesToVisit[toVisitOffset++] = node.child[i];
+            }
+        }
+        if (toVisitOffset == 0) break;
+        currentNodeIndex = nodesToVisit[--toVisitOffset];
+    }
     return false;
 }
 
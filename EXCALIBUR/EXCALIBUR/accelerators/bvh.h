@@ -54,6 +54,13 @@ struct LBVHTreelet {
     BVHBuildNode* buildNodes;
 };
 
+// 延后构建的子树，顶层划分完成后统一作为并行任务构建
+struct BVHBuildTask {
+    BVHBuildNode* node;
+    int start, end;
+    int totalNodes;
+};
+
 struct LinearBVHNode {
     AABB3f bounds;
     union {
@@ -65,6 +72,18 @@ struct LinearBVHNode {
     uint8_t pad[1];        // 确保32个字节为一个对象，提高缓存命中率
 };
 
+// BVH4/BVH8节点，由二叉树合并而来
+// 子节点的包围盒按SoA存放，一组SIMD指令即可同时测试N个子节点
+template <int N>
+struct alignas(32) WideBVHNode {
+    float bMin[3][N];
+    float bMax[3][N];
+    // 内部节点为子节点在数组中的偏移量，叶子为第一个图元的偏移量，空槽为-1
+    int32_t child[N];
+    // 叶子的图元数量，内部节点与空槽为0
+    uint16_t nPrimitives[N];
+};
+
 struct BucketInfo {
     int count = 0;
     AABB3f bounds;
@@ -73,20 +92,30 @@ struct BucketInfo {
 class BVHAccel : public Aggregate {
 public:
     enum SplitMethod { SAH, HLBVH, Middle, EqualCounts };
+    // 遍历时使用的节点布局，BVH4/BVH8由构建好的二叉树合并得到
+    enum NodeLayout { Binary, BVH4, BVH8 };
 
+    // motionSegments > 0时把快门时间[shutterOpen, shutterClose]等分成若干段，
+    // 每个节点额外保存各分段端点的包围盒，遍历时按光线的时间插值，
+    // 运动物体不再用整个快门时间扫过的包围盒。此时只使用二叉布局
     BVHAccel(std::vector<std::shared_ptr<Primitive>> p,
         int maxPrimsInNode = 1,
-        SplitMethod splitMethod = SplitMethod::SAH);
+        SplitMethod splitMethod = SplitMethod::SAH,
+        NodeLayout layout = NodeLayout::Binary,
+        int motionSegments = 0,
+        Float shutterOpen = 0, Float shutterClose = 1);
     ~BVHAccel();
     virtual AABB3f worldBound() const override;
     virtual bool intersect(const Ray& r, SurfaceInteraction*) const override;
     virtual bool intersectP(const Ray& r) const override;
 private:
     // BVHAccel Private Methods
+    // arenas按线程索引取用，buildTasks不为空时较小的子树会被延后并行构建
     BVHBuildNode* recursiveBuild(
-        MemoryArena& arena, std::vector<BVHPrimitiveInfo>& primitiveInfo,
+        std::vector<MemoryArena>& arenas, std::vector<BVHPrimitiveInfo>& primitiveInfo,
         int start, int end, int* totalNodes,
-        std::vector<std::shared_ptr<Primitive>>& orderedPrims);
+        std::vector<std::shared_ptr<Primitive>>& orderedPrims,
+        std::vector<BVHBuildTask>* buildTasks = nullptr) const;
     BVHBuildNode* HLBVHBuild(
         MemoryArena& arena, const std::vector<BVHPrimitiveInfo>& primitiveInfo,
         int* totalNodes,
@@ -101,11 +130,31 @@ private:
         std::vector<BVHBuildNode*>& treeletRoots,
         int start, int end, int* totalNodes) const;
     int flattenBVHTree(BVHBuildNode* node, int* offset);
+    void computeMotionBounds(int nodeIndex, const AABB3f* primMotionBounds);
+    // 光线所在时间段的下标与段内的插值系数
+    void motionSegment(const Ray& ray, int* segment, Float* t) const;
+    inline bool intersectNode(int nodeIndex, const Ray& ray, int segment, Float t,
+        const Vector3f& invDir, const int dirIsNeg[3]) const;
+    template <int N>
+    int collapseWideBVH(BVHBuildNode* node, WideBVHNode<N>* wideNodes, int* offset) const;
+    template <int N>
+    bool intersectWide(const WideBVHNode<N>* wideNodes, const Ray& ray,
+        SurfaceInteraction* isect) const;
+    template <int N>
+    bool intersectPWide(const WideBVHNode<N>* wideNodes, const Ray& ray) const;
 
     const int maxPrimsInNode;
     const SplitMethod splitMethod;
+    const NodeLayout layout;
     std::vector<std::shared_ptr<Primitive>> primitives;
     LinearBVHNode* nodes = nullptr;
+    WideBVHNode<4>* nodes4 = nullptr;
+    WideBVHNode<8>* nodes8 = nullptr;
+    // 第i个节点在各分段端点的包围盒为motionBounds[i * (motionSegments + 1) + k]
+    const int motionSegments;
+    const Float shutterOpen, shutterClose;
+    AABB3f* motionBounds = nullptr;
+    AABB3f bounds;
 };
 
 RENDERING_END
\ No newline at end of file
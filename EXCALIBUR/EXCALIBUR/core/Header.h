@@ -57,6 +57,10 @@ namespace Rendering
 
 	class SampledSpectrum;
 
+	class HeroSpectrum;
+
+	class SampledWavelengths;
+
 	class CObject;
 
 #ifdef RENDERING_SAMPLED_SPECTRUM
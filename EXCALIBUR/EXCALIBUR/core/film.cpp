@@ -71,7 +71,7 @@ void Film::mergeFilmTile(std::unique_ptr<FilmTile> tile) {
         Float xyz[3];
         tilePixel.contribSum.ToXYZ(xyz);
         for (int i = 0; i < 3; ++i) {
-            mergePixel.xyz[i] += xyz[i];
+            mergePixel.xyz[i] += xyz[i] + tilePixel.contribXYZ[i];
         }
         mergePixel.filterWeightSum += tilePixel.filterWeightSum;
     }
@@ -102,6 +102,23 @@ void Film::addSplat(const Point2f& p, Spectrum v) {
     }
 }
 
+void Film::addSplat(const Point2f& p, const HeroSpectrum& v,
+    const SampledWavelengths& wavelengths) {
+    if (!insideExclusive((Point2i)p, croppedPixelBounds)) {
+        return;
+    }
+    Float xyz[3];
+    v.ToXYZ(wavelengths, xyz);
+    if (xyz[1] > _maxSampleLuminance) {
+        Float scale = _maxSampleLuminance / xyz[1];
+        for (int i = 0; i < 3; ++i) xyz[i] *= scale;
+    }
+    Pixel& pixel = getPixel((Point2i)p);
+    for (int i = 0; i < 3; ++i) {
+        pixel.splatXYZ[i].add(xyz[i]);
+    }
+}
+
 void Film::writeImage(Float splatScale/* = 1*/) {
     std::unique_ptr<Float[]> rgb(new Float[3 * croppedPixelBounds.area()]);
     int offset = 0;
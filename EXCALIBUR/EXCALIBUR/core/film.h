@@ -12,6 +12,8 @@ RENDERING_BEGIN
  */
     struct FilmTilePixel {
     Spectrum contribSum = 0.f;
+    // hero wavelength样本在加入时就已经转换到xyz空间
+    Float contribXYZ[3] = { 0.f, 0.f, 0.f };
     Float filterWeightSum = 0.f;
 };
 
@@ -45,38 +47,36 @@ public:
             L *= _maxSampleLuminance / L.y();
         }
 
-        Point2f pFilmDiscrete = pFilm - Vector2f(0.5f, 0.5f);
-        Point2i p0 = (Point2i)ceil(pFilmDiscrete - _filterRadius);
-        Point2i p1 = (Point2i)floor(pFilmDiscrete + _filterRadius) + Point2i(1, 1);
+        // 更新像素值的贡献和以及过滤权重
+        forEachFilterWeight(pFilm, [&](FilmTilePixel& pixel, Float filterWeight) {
+            pixel.contribSum += L * sampleWeight * filterWeight;
+            pixel.filterWeightSum += filterWeight;
+        });
+    }
 
-        int* offsetXList = ALLOCA(int, p1.x - p0.x);
-        for (int x = p0.x; x < p1.x; ++x) {
-            Float offsetX = std::abs((x - pFilmDiscrete.x) * _invFilterRadius.x *
-                _filterTableSize);
-            offsetXList[x - p0.x] = std::min((int)std::floor(offsetX), _filterTableSize - 1);
-        }
-        int* offsetYList = ALLOCA(int, p1.y - p0.y);
-        for (int y = p0.y; y < p1.y; ++y) {
-            Float offsetY = std::abs((y - pFilmDiscrete.y) * _invFilterRadius.y * _filterTableSize);
-            offsetYList[y - p0.y] = std::min((int)std::floor(offsetY), _filterTableSize - 1);
+    /**
+     * 添加hero wavelength样本
+     * @param pFilm        胶片像素上的点
+     * @param L            采样波长上的radiance值
+     * @param wavelengths  采样的波长及其pdf
+     * @param sampleWeight 采样权重(来自于相机)
+     */
+    void addSample(const Point2f& pFilm, const HeroSpectrum& L,
+        const SampledWavelengths& wavelengths, Float sampleWeight = 1.) {
+        Float xyz[3];
+        L.ToXYZ(wavelengths, xyz);
+        if (xyz[1] > _maxSampleLuminance) {
+            Float scale = _maxSampleLuminance / xyz[1];
+            xyz[0] *= scale;
+            xyz[1] *= scale;
+            xyz[2] *= scale;
         }
 
-        // I(x,y) = (∑f(x-xi,y-yi)w(xi,yi)L(xi,yi)) / (∑f(x-xi,y-yi))
-        for (int y = p0.y; y < p1.y; ++y) {
-            for (int x = p0.x; x < p1.x; ++x) {
-                // 计算坐标点对应filter表的偏移量
-                int offset = offsetYList[y - p0.y] * _filterTableSize + offsetXList[x - p0.x];
-                // filterWeight = filter->evaluate(Point2i(x - pFilmDiscrete.x,
-                //                             y - pFilmDiscrete.y));
-                // 由于已经预计算好了，直接查表取值
-                Float filterWeight = _filterTable[offset];
-
-                // 更新像素值的贡献和以及过滤权重
-                FilmTilePixel& pixel = getPixel(Point2i(x, y));
-                pixel.contribSum += L * sampleWeight * filterWeight;
-                pixel.filterWeightSum += filterWeight;
-            }
-        }
+        forEachFilterWeight(pFilm, [&](FilmTilePixel& pixel, Float filterWeight) {
+            for (int i = 0; i < 3; ++i)
+                pixel.contribXYZ[i] += xyz[i] * sampleWeight * filterWeight;
+            pixel.filterWeightSum += filterWeight;
+        });
     }
 
     void addSample2(Point2i pFilm, Spectrum L, Float sampleWeight = 1.) {
@@ -111,6 +111,40 @@ public:
     }
 
 private:
+    // 对样本点filter范围内的每个像素调用func(pixel, filterWeight)
+    template <typename Func>
+    void forEachFilterWeight(const Point2f& pFilm, const Func& func) {
+        Point2f pFilmDiscrete = pFilm - Vector2f(0.5f, 0.5f);
+        Point2i p0 = (Point2i)ceil(pFilmDiscrete - _filterRadius);
+        Point2i p1 = (Point2i)floor(pFilmDiscrete + _filterRadius) + Point2i(1, 1);
+
+        int* offsetXList = ALLOCA(int, p1.x - p0.x);
+        for (int x = p0.x; x < p1.x; ++x) {
+            Float offsetX = std::abs((x - pFilmDiscrete.x) * _invFilterRadius.x *
+                _filterTableSize);
+            offsetXList[x - p0.x] = std::min((int)std::floor(offsetX), _filterTableSize - 1);
+        }
+        int* offsetYList = ALLOCA(int, p1.y - p0.y);
+        for (int y = p0.y; y < p1.y; ++y) {
+            Float offsetY = std::abs((y - pFilmDiscrete.y) * _invFilterRadius.y * _filterTableSize);
+            offsetYList[y - p0.y] = std::min((int)std::floor(offsetY), _filterTableSize - 1);
+        }
+
+        // I(x,y) = (∑f(x-xi,y-yi)w(xi,yi)L(xi,yi)) / (∑f(x-xi,y-yi))
+        for (int y = p0.y; y < p1.y; ++y) {
+            for (int x = p0.x; x < p1.x; ++x) {
+                // 计算坐标点对应filter表的偏移量
+                int offset = offsetYList[y - p0.y] * _filterTableSize + offsetXList[x - p0.x];
+                // filterWeight = filter->evaluate(Point2i(x - pFilmDiscrete.x,
+                //                             y - pFilmDiscrete.y));
+                // 由于已经预计算好了，直接查表取值
+                Float filterWeight = _filterTable[offset];
+
+                func(getPixel(Point2i(x, y)), filterWeight);
+            }
+        }
+    }
+
     // 像素的范围
     const AABB2i _pixelBounds;
 
@@ -174,6 +208,9 @@ public:
      */
     void addSplat(const Point2f& p, Spectrum v);
 
+    void addSplat(const Point2f& p, const HeroSpectrum& v,
+        const SampledWavelengths& wavelengths);
+
     void writeImage(Float splatScale = 1);
 
     void clear();
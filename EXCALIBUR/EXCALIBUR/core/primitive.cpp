@@ -94,5 +94,18 @@ bool TransformedPrimitive::intersectP(const Ray& r) const {
     return _primitive->intersectP(InterpolatedWorldToPrim.exec(r));
 }
 
+void TransformedPrimitive::motionBounds(Float time0, Float time1,
+    AABB3f* bounds0, AABB3f* bounds1) const {
+    AABB3f b = _primitive->worldBound();
+    if (_primitiveToWorld.hasRotation()) {
+        // 旋转时包围盒随时间非线性变化，插值不一定能包住图元，两端都取这段时间扫过的范围
+        *bounds0 = *bounds1 = _primitiveToWorld.motionAABB(b, time0, time1);
+    } else {
+        // 只有平移缩放时8个顶点都是线性运动，两端包围盒的插值总能包住图元
+        *bounds0 = _primitiveToWorld.interpolate(time0).exec(b);
+        *bounds1 = _primitiveToWorld.interpolate(time1).exec(b);
+    }
+}
+
 
 RENDERING_END
\ No newline at end of file
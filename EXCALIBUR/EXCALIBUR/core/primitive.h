@@ -13,6 +13,12 @@ public:
 
     }
     virtual AABB3f worldBound() const = 0;
+    // [time0, time1]两端的包围盒，按时间线性插值后能在整个时间段内包住图元
+    // 静止的图元两端都是worldBound()
+    virtual void motionBounds(Float time0, Float time1,
+        AABB3f* bounds0, AABB3f* bounds1) const {
+        *bounds0 = *bounds1 = worldBound();
+    }
     virtual bool intersect(const Ray& r, SurfaceInteraction*) const = 0;
     virtual bool intersectP(const Ray& r) const = 0;
     virtual const AreaLight* getAreaLight() const = 0;
@@ -73,10 +79,13 @@ public:
             "called";
     }
 
-    virtual AABB3f WorldBound() const {
+    virtual AABB3f worldBound() const {
         return _primitiveToWorld.motionAABB(_primitive->worldBound());
     }
 
+    virtual void motionBounds(Float time0, Float time1,
+        AABB3f* bounds0, AABB3f* bounds1) const;
+
 private:
     std::shared_ptr<Primitive> _primitive;
     const AnimatedTransform _primitiveToWorld;
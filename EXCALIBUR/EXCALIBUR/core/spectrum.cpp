@@ -64,92 +64,101 @@ nloJson SampledSpectrum::toJson() const {
     return ToRGBSpectrum().toJson();
 }
 
-SampledSpectrum SampledSpectrum::FromRGB(const Float rgb[3],
-    SpectrumType type) {
-    SampledSpectrum r;
-    if (type == SpectrumType::Reflectance) {
-        // Convert reflectance spectrum to RGB
-        if (rgb[0] <= rgb[1] && rgb[0] <= rgb[2]) {
-            // Compute reflectance _SampledSpectrum_ with _rgb[0]_ as minimum
-            r += rgb[0] * rgbRefl2SpectWhite;
-            if (rgb[1] <= rgb[2]) {
-                r += (rgb[1] - rgb[0]) * rgbRefl2SpectCyan;
-                r += (rgb[2] - rgb[1]) * rgbRefl2SpectBlue;
-            }
-            else {
-                r += (rgb[2] - rgb[0]) * rgbRefl2SpectCyan;
-                r += (rgb[1] - rgb[2]) * rgbRefl2SpectGreen;
-            }
+void SampledSpectrum::RGBBasis(const Float rgb[3], SpectrumType type,
+    const SampledSpectrum* basis[3], Float weight[3], Float* scale) {
+    // Reflectance和Illuminant的区别只在于基光谱跟缩放系数
+    bool refl = type == SpectrumType::Reflectance;
+    const SampledSpectrum& white = refl ? rgbRefl2SpectWhite : rgbIllum2SpectWhite;
+    const SampledSpectrum& cyan = refl ? rgbRefl2SpectCyan : rgbIllum2SpectCyan;
+    const SampledSpectrum& magenta =
+        refl ? rgbRefl2SpectMagenta : rgbIllum2SpectMagenta;
+    const SampledSpectrum& yellow =
+        refl ? rgbRefl2SpectYellow : rgbIllum2SpectYellow;
+    const SampledSpectrum& red = refl ? rgbRefl2SpectRed : rgbIllum2SpectRed;
+    const SampledSpectrum& green = refl ? rgbRefl2SpectGreen : rgbIllum2SpectGreen;
+    const SampledSpectrum& blue = refl ? rgbRefl2SpectBlue : rgbIllum2SpectBlue;
+    *scale = refl ? .94 : .86445f;
+
+    if (rgb[0] <= rgb[1] && rgb[0] <= rgb[2]) {
+        // Compute _SampledSpectrum_ with _rgb[0]_ as minimum
+        basis[0] = &white;
+        weight[0] = rgb[0];
+        if (rgb[1] <= rgb[2]) {
+            basis[1] = &cyan;
+            weight[1] = rgb[1] - rgb[0];
+            basis[2] = &blue;
+            weight[2] = rgb[2] - rgb[1];
         }
-        else if (rgb[1] <= rgb[0] && rgb[1] <= rgb[2]) {
-            // Compute reflectance _SampledSpectrum_ with _rgb[1]_ as minimum
-            r += rgb[1] * rgbRefl2SpectWhite;
-            if (rgb[0] <= rgb[2]) {
-                r += (rgb[0] - rgb[1]) * rgbRefl2SpectMagenta;
-                r += (rgb[2] - rgb[0]) * rgbRefl2SpectBlue;
-            }
-            else {
-                r += (rgb[2] - rgb[1]) * rgbRefl2SpectMagenta;
-                r += (rgb[0] - rgb[2]) * rgbRefl2SpectRed;
-            }
+        else {
+            basis[1] = &cyan;
+            weight[1] = rgb[2] - rgb[0];
+            basis[2] = &green;
+            weight[2] = rgb[1] - rgb[2];
+        }
+    }
+    else if (rgb[1] <= rgb[0] && rgb[1] <= rgb[2]) {
+        // Compute _SampledSpectrum_ with _rgb[1]_ as minimum
+        basis[0] = &white;
+        weight[0] = rgb[1];
+        if (rgb[0] <= rgb[2]) {
+            basis[1] = &magenta;
+            weight[1] = rgb[0] - rgb[1];
+            basis[2] = &blue;
+            weight[2] = rgb[2] - rgb[0];
         }
         else {
-            // Compute reflectance _SampledSpectrum_ with _rgb[2]_ as minimum
-            r += rgb[2] * rgbRefl2SpectWhite;
-            if (rgb[0] <= rgb[1]) {
-                r += (rgb[0] - rgb[2]) * rgbRefl2SpectYellow;
-                r += (rgb[1] - rgb[0]) * rgbRefl2SpectGreen;
-            }
-            else {
-                r += (rgb[1] - rgb[2]) * rgbRefl2SpectYellow;
-                r += (rgb[0] - rgb[1]) * rgbRefl2SpectRed;
-            }
+            basis[1] = &magenta;
+            weight[1] = rgb[2] - rgb[1];
+            basis[2] = &red;
+            weight[2] = rgb[0] - rgb[2];
         }
-        r *= .94;
     }
     else {
-        // Convert illuminant spectrum to RGB
-        if (rgb[0] <= rgb[1] && rgb[0] <= rgb[2]) {
-            // Compute illuminant _SampledSpectrum_ with _rgb[0]_ as minimum
-            r += rgb[0] * rgbIllum2SpectWhite;
-            if (rgb[1] <= rgb[2]) {
-                r += (rgb[1] - rgb[0]) * rgbIllum2SpectCyan;
-                r += (rgb[2] - rgb[1]) * rgbIllum2SpectBlue;
-            }
-            else {
-                r += (rgb[2] - rgb[0]) * rgbIllum2SpectCyan;
-                r += (rgb[1] - rgb[2]) * rgbIllum2SpectGreen;
-            }
-        }
-        else if (rgb[1] <= rgb[0] && rgb[1] <= rgb[2]) {
-            // Compute illuminant _SampledSpectrum_ with _rgb[1]_ as minimum
-            r += rgb[1] * rgbIllum2SpectWhite;
-            if (rgb[0] <= rgb[2]) {
-                r += (rgb[0] - rgb[1]) * rgbIllum2SpectMagenta;
-                r += (rgb[2] - rgb[0]) * rgbIllum2SpectBlue;
-            }
-            else {
-                r += (rgb[2] - rgb[1]) * rgbIllum2SpectMagenta;
-                r += (rgb[0] - rgb[2]) * rgbIllum2SpectRed;
-            }
+        // Compute _SampledSpectrum_ with _rgb[2]_ as minimum
+        basis[0] = &white;
+        weight[0] = rgb[2];
+        if (rgb[0] <= rgb[1]) {
+            basis[1] = &yellow;
+            weight[1] = rgb[0] - rgb[2];
+            basis[2] = &green;
+            weight[2] = rgb[1] - rgb[0];
         }
         else {
-            // Compute illuminant _SampledSpectrum_ with _rgb[2]_ as minimum
-            r += rgb[2] * rgbIllum2SpectWhite;
-            if (rgb[0] <= rgb[1]) {
-                r += (rgb[0] - rgb[2]) * rgbIllum2SpectYellow;
-                r += (rgb[1] - rgb[0]) * rgbIllum2SpectGreen;
-            }
-            else {
-                r += (rgb[1] - rgb[2]) * rgbIllum2SpectYellow;
-                r += (rgb[0] - rgb[1]) * rgbIllum2SpectRed;
-            }
+            basis[1] = &yellow;
+            weight[1] = rgb[1] - rgb[2];
+            basis[2] = &red;
+            weight[2] = rgb[0] - rgb[1];
         }
-        r *= .86445f;
     }
+}
+
+SampledSpectrum SampledSpectrum::FromRGB(const Float rgb[3],
+    SpectrumType type) {
+    const SampledSpectrum* basis[3];
+    Float weight[3], scale;
+    RGBBasis(rgb, type, basis, weight, &scale);
+    SampledSpectrum r;
+    for (int i = 0; i < 3; ++i) r += weight[i] * *basis[i];
+    r *= scale;
     return r.clamp();
 }
 
+HeroSpectrum SampledSpectrum::FromRGB(const Float rgb[3],
+    const SampledWavelengths& wavelengths, SpectrumType type) {
+    const SampledSpectrum* basis[3];
+    Float weight[3], scale;
+    RGBBasis(rgb, type, basis, weight, &scale);
+    // 只取采样波长所在区间的值，先在标量上累加，最后一次写入
+    HeroSpectrum r;
+    for (int i = 0; i < nHeroWavelengths; ++i) {
+        int bin = wavelengths.Bin(i);
+        Float v = weight[0] * basis[0]->c[bin] + weight[1] * basis[1]->c[bin] +
+            weight[2] * basis[2]->c[bin];
+        r[i] = std::max(v * scale, (Float)0);
+    }
+    return r;
+}
+
 SampledSpectrum::SampledSpectrum(const RGBSpectrum& r, SpectrumType t) {
     Float rgb[3];
     r.ToRGB(rgb);
@@ -943,6 +952,128 @@ void BlackbodyNormalized(const Float* lambda, int n, Float T, Float* Le) {
     for (int i = 0; i < n; ++i) Le[i] /= maxL;
 }
 
+// CIE匹配函数的采样间隔是1纳米，直接按下标线性插值，不用二分查找
+static void CIEMatch(Float lambda, Float xyz[3]) {
+    Float offset = Rendering::clamp(lambda - CIE_lambda[0], 0,
+        nCIESamples - 1);
+    int i = std::min((int)offset, nCIESamples - 2);
+    Float t = offset - i;
+    xyz[0] = lerp(t, CIE_X[i], CIE_X[i + 1]);
+    xyz[1] = lerp(t, CIE_Y[i], CIE_Y[i + 1]);
+    xyz[2] = lerp(t, CIE_Z[i], CIE_Z[i + 1]);
+}
+
+// 可见度重要性采样的pdf正比于1 / cosh^2(k(lambda - 538))，其CDF就是tanh
+static const Float visibleK = 0.0072f;
+static const Float visibleCenter = 538;
+
+void SampledWavelengths::ComputeBins() {
+    Float invBinWidth =
+        nSpectralSamples / Float(sampledLambdaEnd - sampledLambdaStart);
+    for (int i = 0; i < nHeroWavelengths; ++i) {
+        int bin = (int)((_lambda[i] - sampledLambdaStart) * invBinWidth);
+        _bin[i] = Rendering::clamp(bin, 0, nSpectralSamples - 1);
+    }
+}
+
+SampledWavelengths SampledWavelengths::SampleUniform(Float u) {
+    SampledWavelengths ret;
+    Float range = sampledLambdaEnd - sampledLambdaStart;
+    for (int i = 0; i < nHeroWavelengths; ++i) {
+        // 在[0, 1)上按1 / nHeroWavelengths的间隔旋转hero波长的采样值
+        Float up = u + Float(i) / nHeroWavelengths;
+        if (up >= 1) up -= 1;
+        ret._lambda[i] = lerp(up, sampledLambdaStart, sampledLambdaEnd);
+        ret._pdf[i] = 1 / range;
+    }
+    ret.ComputeBins();
+    return ret;
+}
+
+SampledWavelengths SampledWavelengths::SampleVisible(Float u) {
+    static const Float cdf0 =
+        std::tanh(visibleK * (sampledLambdaStart - visibleCenter));
+    static const Float cdf1 =
+        std::tanh(visibleK * (sampledLambdaEnd - visibleCenter));
+    SampledWavelengths ret;
+    for (int i = 0; i < nHeroWavelengths; ++i) {
+        Float up = u + Float(i) / nHeroWavelengths;
+        if (up >= 1) up -= 1;
+        // 旋转之后的采样值仍是均匀分布，每个波长单独服从可见度分布
+        // t = tanh(k(lambda - 538))，1 / cosh^2 = 1 - t^2，atanh(t)只需要一次log
+        Float t = lerp(up, cdf0, cdf1);
+        Float lambda = visibleCenter +
+            0.5f * std::log((1 + t) / (1 - t)) / visibleK;
+        ret._lambda[i] =
+            Rendering::clamp(lambda, sampledLambdaStart, sampledLambdaEnd);
+        ret._pdf[i] = visibleK * (1 - t * t) / (cdf1 - cdf0);
+    }
+    ret.ComputeBins();
+    return ret;
+}
+
+HeroSpectrum HeroSpectrum::FromSampled(const Float* lambda, const Float* v,
+    int n, const SampledWavelengths& wavelengths) {
+    // Sort samples if unordered, use sorted for returned spectrum
+    if (!SpectrumSamplesSorted(lambda, v, n)) {
+        std::vector<Float> slambda(&lambda[0], &lambda[n]);
+        std::vector<Float> sv(&v[0], &v[n]);
+        SortSpectrumSamples(&slambda[0], &sv[0], n);
+        return FromSampled(&slambda[0], &sv[0], n, wavelengths);
+    }
+    HeroSpectrum r;
+    for (int i = 0; i < nHeroWavelengths; ++i)
+        r.c[i] = InterpolateSpectrumSamples(lambda, v, n, wavelengths[i]);
+    return r;
+}
+
+HeroSpectrum HeroSpectrum::FromBlackbody(Float T,
+    const SampledWavelengths& wavelengths) {
+    HeroSpectrum r;
+    BlackbodyNormalized(wavelengths.Lambda(), nHeroWavelengths, T, r.c);
+    return r;
+}
+
+void HeroSpectrum::ToXYZ(const SampledWavelengths& wavelengths,
+    Float xyz[3]) const {
+    xyz[0] = xyz[1] = xyz[2] = 0.f;
+    const HeroSpectrum& pdf = wavelengths.Pdf();
+    for (int i = 0; i < nHeroWavelengths; ++i) {
+        // 已终止的波长pdf为0，不参与平均
+        if (pdf[i] == 0) continue;
+        Float v = c[i] / pdf[i];
+        Float match[3];
+        CIEMatch(wavelengths[i], match);
+        xyz[0] += match[0] * v;
+        xyz[1] += match[1] * v;
+        xyz[2] += match[2] * v;
+    }
+    // 与SampledSpectrum::ToXYZ的归一化方式一致
+    Float scale = 1 / Float(CIE_Y_integral * nHeroWavelengths);
+    xyz[0] *= scale;
+    xyz[1] *= scale;
+    xyz[2] *= scale;
+}
+
+Float HeroSpectrum::y(const SampledWavelengths& wavelengths) const {
+    Float yy = 0.f;
+    const HeroSpectrum& pdf = wavelengths.Pdf();
+    for (int i = 0; i < nHeroWavelengths; ++i) {
+        if (pdf[i] == 0) continue;
+        Float match[3];
+        CIEMatch(wavelengths[i], match);
+        yy += match[1] * c[i] / pdf[i];
+    }
+    return yy / Float(CIE_Y_integral * nHeroWavelengths);
+}
+
+HeroSpectrum SampledSpectrum::Sample(
+    const SampledWavelengths& wavelengths) const {
+    HeroSpectrum r;
+    for (int i = 0; i < nHeroWavelengths; ++i) r[i] = c[wavelengths.Bin(i)];
+    return r;
+}
+
 // Spectral Data Definitions
 SampledSpectrum SampledSpectrum::X;
 SampledSpectrum SampledSpectrum::Y;
@@ -2,6 +2,8 @@
 #define spectrum_h
 
 #include "Header.h"
+#include <immintrin.h>
+#include <type_traits>
 
 RENDERING_BEGIN
 
@@ -56,24 +58,223 @@ extern const Float RGBIllum2SpectRed[nRGB2SpectSamples];
 extern const Float RGBIllum2SpectGreen[nRGB2SpectSamples];
 extern const Float RGBIllum2SpectBlue[nRGB2SpectSamples];
 
+// 系数光谱用SIMD寄存器逐组处理，x64上SSE总是可用，
+// 编译开启AVX(AVX-512)时，采样数不少于8(16)的光谱改用更宽的寄存器，
+// 双精度编译保持标量
+#ifndef FLOAT_AS_DOUBLE
+struct SpectrumLanes4 {
+    typedef __m128 Vec;
+    static CONSTEXPR int Width = 4;
+
+    static Vec Load(const Float* p) { return _mm_loadu_ps(p); }
+    static void Store(Float* p, Vec v) { _mm_storeu_ps(p, v); }
+    static Vec Set1(Float v) { return _mm_set1_ps(v); }
+    static Vec Add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+    static Vec Sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+    static Vec Mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+    static Vec Div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+    static Vec Neg(Vec a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+    static Vec Sqrt(Vec a) { return _mm_sqrt_ps(a); }
+    // 注意：NaN会被夹到边界上，原先的标量循环会保留NaN
+    static Vec Clamp(Vec a, Float low, Float high) {
+        return _mm_max_ps(_mm_min_ps(a, Set1(high)), Set1(low));
+    }
+
+    // Cephes的expf，在截断范围内相对误差小于2ulp
+    static Vec Exp(Vec x) {
+        x = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(88.3762626647949f)),
+            _mm_set1_ps(-88.3762626647949f));
+
+        // exp(x) = 2^n * exp(g)，|g| <= ln(2) / 2
+        __m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)),
+            _mm_set1_ps(0.5f));
+        __m128 tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+        fx = _mm_sub_ps(tmp, _mm_and_ps(_mm_cmpgt_ps(tmp, fx), _mm_set1_ps(1.f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+        x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+        __m128 z = _mm_mul_ps(x, x);
+        __m128 y = _mm_set1_ps(1.9875691500e-4f);
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+        y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+        y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.f));
+
+        // 直接构造指数位得到2^n
+        __m128i n = _mm_slli_epi32(
+            _mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f)), 23);
+        return _mm_mul_ps(y, _mm_castsi128_ps(n));
+    }
+
+    static bool AnyNonZero(Vec a) {
+        return _mm_movemask_ps(_mm_cmpneq_ps(a, _mm_setzero_ps())) != 0;
+    }
+    static bool AnyNaN(Vec a) {
+        return _mm_movemask_ps(_mm_cmpunord_ps(a, a)) != 0;
+    }
+    static bool AnyNotEqual(Vec a, Vec b) {
+        return _mm_movemask_ps(_mm_cmpneq_ps(a, b)) != 0;
+    }
+    static Float Sum(Vec a) {
+        __m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+        return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+    }
+};
+
+#ifdef __AVX__
+struct SpectrumLanes8 {
+    typedef __m256 Vec;
+    static CONSTEXPR int Width = 8;
+
+    static Vec Load(const Float* p) { return _mm256_loadu_ps(p); }
+    static void Store(Float* p, Vec v) { _mm256_storeu_ps(p, v); }
+    static Vec Set1(Float v) { return _mm256_set1_ps(v); }
+    static Vec Add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+    static Vec Sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+    static Vec Mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+    static Vec Div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+    static Vec Neg(Vec a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+    static Vec Sqrt(Vec a) { return _mm256_sqrt_ps(a); }
+    static Vec Clamp(Vec a, Float low, Float high) {
+        return _mm256_max_ps(_mm256_min_ps(a, Set1(high)), Set1(low));
+    }
+
+    // AVX没有256位整数运算，指数部分拆成两个SSE计算
+    static Vec Exp(Vec x) {
+        return _mm256_insertf128_ps(
+            _mm256_castps128_ps256(SpectrumLanes4::Exp(_mm256_castps256_ps128(x))),
+            SpectrumLanes4::Exp(_mm256_extractf128_ps(x, 1)), 1);
+    }
+
+    static bool AnyNonZero(Vec a) {
+        return _mm256_movemask_ps(
+            _mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_UQ)) != 0;
+    }
+    static bool AnyNaN(Vec a) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a, a, _CMP_UNORD_Q)) != 0;
+    }
+    static bool AnyNotEqual(Vec a, Vec b) {
+        return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)) != 0;
+    }
+    static Float Sum(Vec a) {
+        return SpectrumLanes4::Sum(_mm_add_ps(_mm256_castps256_ps128(a),
+            _mm256_extractf128_ps(a, 1)));
+    }
+};
+#endif  // __AVX__
+
+#ifdef __AVX512F__
+struct SpectrumLanes16 {
+    typedef __m512 Vec;
+    static CONSTEXPR int Width = 16;
+
+    static Vec Load(const Float* p) { return _mm512_loadu_ps(p); }
+    static void Store(Float* p, Vec v) { _mm512_storeu_ps(p, v); }
+    static Vec Set1(Float v) { return _mm512_set1_ps(v); }
+    static Vec Add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+    static Vec Sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+    static Vec Mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+    static Vec Div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+    static Vec Neg(Vec a) {
+        return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a),
+            _mm512_set1_epi32(0x80000000)));
+    }
+    static Vec Sqrt(Vec a) { return _mm512_sqrt_ps(a); }
+    static Vec Clamp(Vec a, Float low, Float high) {
+        return _mm512_max_ps(_mm512_min_ps(a, Set1(high)), Set1(low));
+    }
+
+    static Vec Exp(Vec x) {
+        Vec ret = x;
+        ret = _mm512_insertf32x4(ret, SpectrumLanes4::Exp(_mm512_extractf32x4_ps(x, 0)), 0);
+        ret = _mm512_insertf32x4(ret, SpectrumLanes4::Exp(_mm512_extractf32x4_ps(x, 1)), 1);
+        ret = _mm512_insertf32x4(ret, SpectrumLanes4::Exp(_mm512_extractf32x4_ps(x, 2)), 2);
+        ret = _mm512_insertf32x4(ret, SpectrumLanes4::Exp(_mm512_extractf32x4_ps(x, 3)), 3);
+        return ret;
+    }
+
+    static bool AnyNonZero(Vec a) {
+        return _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_NEQ_UQ) != 0;
+    }
+    static bool AnyNaN(Vec a) {
+        return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q) != 0;
+    }
+    static bool AnyNotEqual(Vec a, Vec b) {
+        return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ) != 0;
+    }
+    static Float Sum(Vec a) { return _mm512_reduce_add_ps(a); }
+};
+#endif  // __AVX512F__
+
+#else
+struct SpectrumLanes1 {
+    typedef Float Vec;
+    static CONSTEXPR int Width = 1;
+
+    static Vec Load(const Float* p) { return *p; }
+    static void Store(Float* p, Vec v) { *p = v; }
+    static Vec Set1(Float v) { return v; }
+    static Vec Add(Vec a, Vec b) { return a + b; }
+    static Vec Sub(Vec a, Vec b) { return a - b; }
+    static Vec Mul(Vec a, Vec b) { return a * b; }
+    static Vec Div(Vec a, Vec b) { return a / b; }
+    static Vec Neg(Vec a) { return -a; }
+    static Vec Sqrt(Vec a) { return std::sqrt(a); }
+    static Vec Clamp(Vec a, Float low, Float high) {
+        return Rendering::clamp(a, low, high);
+    }
+    static Vec Exp(Vec a) { return std::exp(a); }
+    static bool AnyNonZero(Vec a) { return a != 0.; }
+    static bool AnyNaN(Vec a) { return std::isnan(a); }
+    static bool AnyNotEqual(Vec a, Vec b) { return a != b; }
+    static Float Sum(Vec a) { return a; }
+};
+#endif  // FLOAT_AS_DOUBLE
+
+template <int nSpectrumSamples>
+struct SpectrumLanesFor {
+#if defined(FLOAT_AS_DOUBLE)
+    typedef SpectrumLanes1 type;
+#elif defined(__AVX512F__)
+    typedef typename std::conditional<(nSpectrumSamples >= 16), SpectrumLanes16,
+        typename std::conditional<(nSpectrumSamples >= 8), SpectrumLanes8,
+        SpectrumLanes4>::type>::type type;
+#elif defined(__AVX__)
+    typedef typename std::conditional<(nSpectrumSamples >= 8), SpectrumLanes8,
+        SpectrumLanes4>::type type;
+#else
+    typedef SpectrumLanes4 type;
+#endif
+};
+
 // Spectrum Declarations
 template <int nSpectrumSamples>
 class CoefficientSpectrum {
+    typedef typename SpectrumLanesFor<nSpectrumSamples>::type Lanes;
+
 public:
+    // 系数补齐到整数个SIMD寄存器，所有运算都处理全部通道，
+    // 补齐部分始终为0，IsBlack()，HasNaNs()和==依赖这一点
+    static CONSTEXPR int nPaddedSamples =
+        (nSpectrumSamples + Lanes::Width - 1) / Lanes::Width * Lanes::Width;
+
     // CoefficientSpectrum Public Methods
     CoefficientSpectrum(Float v = 0.f) {
         for (int i = 0; i < nSpectrumSamples; ++i) c[i] = v;
+        ClearPadding();
         DCHECK(!HasNaNs());
     }
 #ifdef DEBUG
     CoefficientSpectrum(const CoefficientSpectrum& s) {
         DCHECK(!s.HasNaNs());
-        for (int i = 0; i < nSpectrumSamples; ++i) c[i] = s.c[i];
+        for (int i = 0; i < nPaddedSamples; ++i) c[i] = s.c[i];
     }
 
     CoefficientSpectrum& operator=(const CoefficientSpectrum& s) {
         DCHECK(!s.HasNaNs());
-        for (int i = 0; i < nSpectrumSamples; ++i) c[i] = s.c[i];
+        for (int i = 0; i < nPaddedSamples; ++i) c[i] = s.c[i];
         return *this;
     }
 #endif  // DEBUG
@@ -87,49 +288,59 @@ public:
     }
     CoefficientSpectrum& operator+=(const CoefficientSpectrum& s2) {
         DCHECK(!s2.HasNaNs());
-        for (int i = 0; i < nSpectrumSamples; ++i) c[i] += s2.c[i];
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(c + i, Lanes::Add(Lanes::Load(c + i), Lanes::Load(s2.c + i)));
         return *this;
     }
     CoefficientSpectrum operator+(const CoefficientSpectrum& s2) const {
         DCHECK(!s2.HasNaNs());
-        CoefficientSpectrum ret = *this;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] += s2.c[i];
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Add(Lanes::Load(c + i), Lanes::Load(s2.c + i)));
         return ret;
     }
     CoefficientSpectrum operator-(const CoefficientSpectrum& s2) const {
         DCHECK(!s2.HasNaNs());
-        CoefficientSpectrum ret = *this;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] -= s2.c[i];
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Sub(Lanes::Load(c + i), Lanes::Load(s2.c + i)));
         return ret;
     }
     CoefficientSpectrum operator/(const CoefficientSpectrum& s2) const {
         DCHECK(!s2.HasNaNs());
-        CoefficientSpectrum ret = *this;
-        for (int i = 0; i < nSpectrumSamples; ++i) {
-            CHECK_NE(s2.c[i], 0);
-            ret.c[i] /= s2.c[i];
-        }
+        for (int i = 0; i < nSpectrumSamples; ++i) CHECK_NE(s2.c[i], 0);
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Div(Lanes::Load(c + i), Lanes::Load(s2.c + i)));
+        // 补齐部分是0 / 0
+        ret.ClearPadding();
         return ret;
     }
     CoefficientSpectrum operator*(const CoefficientSpectrum& sp) const {
         DCHECK(!sp.HasNaNs());
-        CoefficientSpectrum ret = *this;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] *= sp.c[i];
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Mul(Lanes::Load(c + i), Lanes::Load(sp.c + i)));
         return ret;
     }
     CoefficientSpectrum& operator*=(const CoefficientSpectrum& sp) {
         DCHECK(!sp.HasNaNs());
-        for (int i = 0; i < nSpectrumSamples; ++i) c[i] *= sp.c[i];
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(c + i, Lanes::Mul(Lanes::Load(c + i), Lanes::Load(sp.c + i)));
         return *this;
     }
     CoefficientSpectrum operator*(Float a) const {
-        CoefficientSpectrum ret = *this;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] *= a;
+        const typename Lanes::Vec va = Lanes::Set1(a);
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Mul(Lanes::Load(c + i), va));
         DCHECK(!ret.HasNaNs());
         return ret;
     }
     CoefficientSpectrum& operator*=(Float a) {
-        for (int i = 0; i < nSpectrumSamples; ++i) c[i] *= a;
+        const typename Lanes::Vec va = Lanes::Set1(a);
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(c + i, Lanes::Mul(Lanes::Load(c + i), va));
         DCHECK(!HasNaNs());
         return *this;
     }
@@ -141,33 +352,39 @@ public:
     CoefficientSpectrum operator/(Float a) const {
         CHECK_NE(a, 0);
         DCHECK(!std::isnan(a));
-        CoefficientSpectrum ret = *this;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] /= a;
+        const typename Lanes::Vec va = Lanes::Set1(a);
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Div(Lanes::Load(c + i), va));
         DCHECK(!ret.HasNaNs());
         return ret;
     }
     CoefficientSpectrum& operator/=(Float a) {
         CHECK_NE(a, 0);
         DCHECK(!std::isnan(a));
-        for (int i = 0; i < nSpectrumSamples; ++i) c[i] /= a;
+        const typename Lanes::Vec va = Lanes::Set1(a);
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(c + i, Lanes::Div(Lanes::Load(c + i), va));
         return *this;
     }
     bool operator==(const CoefficientSpectrum& sp) const {
-        for (int i = 0; i < nSpectrumSamples; ++i)
-            if (c[i] != sp.c[i]) return false;
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            if (Lanes::AnyNotEqual(Lanes::Load(c + i), Lanes::Load(sp.c + i)))
+                return false;
         return true;
     }
     bool operator!=(const CoefficientSpectrum& sp) const {
         return !(*this == sp);
     }
     bool IsBlack() const {
-        for (int i = 0; i < nSpectrumSamples; ++i)
-            if (c[i] != 0.) return false;
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            if (Lanes::AnyNonZero(Lanes::Load(c + i))) return false;
         return true;
     }
     friend CoefficientSpectrum Sqrt(const CoefficientSpectrum& s) {
-        CoefficientSpectrum ret;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] = std::sqrt(s.c[i]);
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Sqrt(Lanes::Load(s.c + i)));
         DCHECK(!ret.HasNaNs());
         return ret;
     }
@@ -175,16 +392,33 @@ public:
     friend inline CoefficientSpectrum<n> Pow(const CoefficientSpectrum<n>& s,
         Float e);
     CoefficientSpectrum operator-() const {
-        CoefficientSpectrum ret;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] = -c[i];
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Neg(Lanes::Load(c + i)));
         return ret;
     }
     friend CoefficientSpectrum Exp(const CoefficientSpectrum& s) {
-        CoefficientSpectrum ret;
-        for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] = std::exp(s.c[i]);
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Exp(Lanes::Load(s.c + i)));
+        // 补齐部分是exp(0) = 1
+        ret.ClearPadding();
         DCHECK(!ret.HasNaNs());
         return ret;
     }
+    // 以w为权重的系数之和，w和光谱一样补齐
+    Float WeightedSum(const Float w[nPaddedSamples]) const {
+        // 只有一个寄存器时，水平求和反而更慢
+        if (nPaddedSamples == Lanes::Width) {
+            Float sum = c[0] * w[0];
+            for (int i = 1; i < nSpectrumSamples; ++i) sum += c[i] * w[i];
+            return sum;
+        }
+        typename Lanes::Vec acc = Lanes::Mul(Lanes::Load(c), Lanes::Load(w));
+        for (int i = Lanes::Width; i < nPaddedSamples; i += Lanes::Width)
+            acc = Lanes::Add(acc, Lanes::Mul(Lanes::Load(c + i), Lanes::Load(w + i)));
+        return Lanes::Sum(acc);
+    }
     friend std::ostream& operator<<(std::ostream& os,
         const CoefficientSpectrum& s) {
         return os << s.ToString();
@@ -199,9 +433,10 @@ public:
         return str;
     }
     CoefficientSpectrum clamp(Float low = 0, Float high = Infinity) const {
-        CoefficientSpectrum ret;
-        for (int i = 0; i < nSpectrumSamples; ++i)
-            ret.c[i] = Rendering::clamp(c[i], low, high);
+        CoefficientSpectrum ret(NoInit{});
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            Lanes::Store(ret.c + i, Lanes::Clamp(Lanes::Load(c + i), low, high));
+        ret.ClearPadding();
         DCHECK(!ret.HasNaNs());
         return ret;
     }
@@ -212,8 +447,8 @@ public:
         return m;
     }
     bool HasNaNs() const {
-        for (int i = 0; i < nSpectrumSamples; ++i)
-            if (std::isnan(c[i])) return true;
+        for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+            if (Lanes::AnyNaN(Lanes::Load(c + i))) return true;
         return false;
     }
     bool HasInfs() const {
@@ -250,8 +485,91 @@ public:
     static const int nSamples = nSpectrumSamples;
 
 protected:
+    // 结果会写满全部通道时使用，不做初始化
+    struct NoInit {};
+    explicit CoefficientSpectrum(NoInit) {}
+
+    void ClearPadding() {
+        for (int i = nSpectrumSamples; i < nPaddedSamples; ++i) c[i] = 0;
+    }
+
     // CoefficientSpectrum Protected Data
-    Float c[nSpectrumSamples];
+    alignas(Lanes::Width * sizeof(Float)) Float c[nPaddedSamples];
+};
+
+// hero wavelength光谱渲染每条相机路径只采样4个波长，
+// 第一个是hero波长，其余3个由hero波长的采样值等间隔旋转得到，
+// 4个波长的值刚好放进一个SIMD寄存器
+static const int nHeroWavelengths = 4;
+
+class HeroSpectrum : public CoefficientSpectrum<nHeroWavelengths> {
+public:
+    HeroSpectrum(Float v = 0.f) : CoefficientSpectrum(v) {}
+    HeroSpectrum(const CoefficientSpectrum<nHeroWavelengths>& v)
+        : CoefficientSpectrum<nHeroWavelengths>(v) {}
+
+    static HeroSpectrum FromSampled(const Float* lambda, const Float* v, int n,
+        const SampledWavelengths& wavelengths);
+
+    // 在采样的波长上求归一化黑体辐射，用于光谱光源
+    static HeroSpectrum FromBlackbody(Float T,
+        const SampledWavelengths& wavelengths);
+
+    // 除以各波长的pdf之后再求平均，在样本加入胶片时转换到xyz空间
+    void ToXYZ(const SampledWavelengths& wavelengths, Float xyz[3]) const;
+
+    Float y(const SampledWavelengths& wavelengths) const;
+};
+
+/**
+ * 一条相机路径上采样的波长以及对应的pdf
+ * 波长在[sampledLambdaStart, sampledLambdaEnd]中按人眼的可见度重要性采样，
+ * 结果与SampledSpectrum的60个采样点积分的是同一个范围
+ */
+class SampledWavelengths {
+public:
+    static SampledWavelengths SampleUniform(Float u);
+
+    static SampledWavelengths SampleVisible(Float u);
+
+    Float operator[](int i) const {
+        DCHECK(i >= 0 && i < nHeroWavelengths);
+        return _lambda[i];
+    }
+
+    const Float* Lambda() const { return _lambda; }
+
+    // 第i个波长落在SampledSpectrum的哪个采样区间
+    int Bin(int i) const {
+        DCHECK(i >= 0 && i < nHeroWavelengths);
+        return _bin[i];
+    }
+
+    const HeroSpectrum& Pdf() const { return _pdf; }
+
+    /**
+     * 遇到折射率随波长变化的界面(色散)时，只有hero波长还能沿着这条路径走下去，
+     * 其余波长的pdf置0，hero波长的pdf除以波长数，使估计量保持无偏
+     */
+    void TerminateSecondary() {
+        if (SecondaryTerminated()) return;
+        for (int i = 1; i < nHeroWavelengths; ++i) _pdf[i] = 0;
+        _pdf[0] /= nHeroWavelengths;
+    }
+
+    bool SecondaryTerminated() const {
+        for (int i = 1; i < nHeroWavelengths; ++i)
+            if (_pdf[i] != 0) return false;
+        return true;
+    }
+
+private:
+    void ComputeBins();
+
+    Float _lambda[nHeroWavelengths];
+    HeroSpectrum _pdf;
+    // 采样时预先算好，查表时不用每次都做浮点到整数的转换
+    int _bin[nHeroWavelengths];
 };
 
 // 采样光谱默认从400到700纳米采样，总共有60个采样点
@@ -363,12 +681,9 @@ public:
     }
 
     void ToXYZ(Float xyz[3]) const {
-        xyz[0] = xyz[1] = xyz[2] = 0.f;
-        for (int i = 0; i < nSpectralSamples; ++i) {
-            xyz[0] += X.c[i] * c[i];
-            xyz[1] += Y.c[i] * c[i];
-            xyz[2] += Z.c[i] * c[i];
-        }
+        xyz[0] = WeightedSum(X.c);
+        xyz[1] = WeightedSum(Y.c);
+        xyz[2] = WeightedSum(Z.c);
         Float scale = Float(sampledLambdaEnd - sampledLambdaStart) /
             Float(CIE_Y_integral * nSpectralSamples);
         xyz[0] *= scale;
@@ -377,8 +692,7 @@ public:
     }
 
     Float y() const {
-        Float yy = 0.f;
-        for (int i = 0; i < nSpectralSamples; ++i) yy += Y.c[i] * c[i];
+        Float yy = WeightedSum(Y.c);
         return yy * Float(sampledLambdaEnd - sampledLambdaStart) /
             Float(CIE_Y_integral * nSpectralSamples);
     }
@@ -395,6 +709,10 @@ public:
 
     static SampledSpectrum FromRGB(
         const Float rgb[3], SpectrumType type = SpectrumType::Illuminant);
+    // 只在采样的波长上重建，不需要算出全部60个采样点
+    static HeroSpectrum FromRGB(const Float rgb[3],
+        const SampledWavelengths& wavelengths,
+        SpectrumType type = SpectrumType::Illuminant);
     static SampledSpectrum FromXYZ(
         const Float xyz[3], SpectrumType type = SpectrumType::Reflectance) {
         Float rgb[3];
@@ -404,7 +722,14 @@ public:
     SampledSpectrum(const RGBSpectrum& r,
         SpectrumType type = SpectrumType::Reflectance);
 
+    // 取采样波长所在区间的值
+    HeroSpectrum Sample(const SampledWavelengths& wavelengths) const;
+
 private:
+    // 选出重建RGB所用的3个基光谱及其权重
+    static void RGBBasis(const Float rgb[3], SpectrumType type,
+        const SampledSpectrum* basis[3], Float weight[3], Float* scale);
+
     // SampledSpectrum Private Data
     static SampledSpectrum X, Y, Z;
     static SampledSpectrum rgbRefl2SpectWhite, rgbRefl2SpectCyan;
@@ -473,8 +798,9 @@ public:
         return r;
     }
     Float y() const {
-        const Float YWeight[3] = { 0.212671f, 0.715160f, 0.072169f };
-        return YWeight[0] * c[0] + YWeight[1] * c[1] + YWeight[2] * c[2];
+        alignas(16) static CONSTEXPR Float YWeight[nPaddedSamples] = {
+            0.212671f, 0.715160f, 0.072169f };
+        return WeightedSum(YWeight);
     }
 
     /*
@@ -511,6 +837,7 @@ inline CoefficientSpectrum<nSpectrumSamples> Pow(
     const CoefficientSpectrum<nSpectrumSamples>& s, Float e) {
     CoefficientSpectrum<nSpectrumSamples> ret;
     for (int i = 0; i < nSpectrumSamples; ++i) ret.c[i] = std::pow(s.c[i], e);
+    ret.ClearPadding();
     DCHECK(!ret.HasNaNs());
     return ret;
 }
@@ -712,17 +712,21 @@ AnimatedTransform::AnimatedTransform(const Transform* startTransform,
 }
 
 AABB3f AnimatedTransform::motionAABB(const AABB3f& b) const {
+    return motionAABB(b, _startTime, _endTime);
+}
+
+AABB3f AnimatedTransform::motionAABB(const AABB3f& b, Float time0, Float time1) const {
     if (!_actuallyAnimated)
         // 如果没有变化，直接使用变换
         return _startTransform->exec(b);
     if (_hasRotation == false)
         // 如果没有旋转，只有平移缩放，可以用两个变换的并集
         // 因为没有只有平移缩放的情况下 p'= f(t) * p，p'与t呈线性关系
-        return unionSet(_startTransform->exec(b), _endTransform->exec(b));
+        return unionSet(interpolate(time0).exec(b), interpolate(time1).exec(b));
     // 如果有旋转，则用最暴力的方式，计算8个顶点轨迹的包围盒，然后取并集
     AABB3f bounds;
     for (int corner = 0; corner < 8; ++corner)
-        bounds = unionSet(bounds, boundPointMotion(b.corner(corner)));
+        bounds = unionSet(bounds, boundPointMotion(b.corner(corner), time0, time1));
     return bounds;
 }
 
@@ -775,11 +779,18 @@ Transform AnimatedTransform::interpolate(Float time) const {
 }
 
 AABB3f AnimatedTransform::boundPointMotion(const Point3f& p) const {
+    return boundPointMotion(p, _startTime, _endTime);
+}
+
+AABB3f AnimatedTransform::boundPointMotion(const Point3f& p, Float time0, Float time1) const {
     if (!_actuallyAnimated)
         return AABB3f(_startTransform->exec(p));
-    AABB3f bounds(_startTransform->exec(p), _endTransform->exec(p));
+    AABB3f bounds(exec(time0, p), exec(time1, p));
     Float cosTheta = dot(_R[0], _R[1]);
     Float theta = std::acos(clamp(cosTheta, -1, 1));
+    // 导数函数以[0, 1]为定义域，只在子区间内寻找极值点
+    Float u0 = clamp((time0 - _startTime) / (_endTime - _startTime), 0, 1);
+    Float u1 = clamp((time1 - _startTime) / (_endTime - _startTime), 0, 1);
 
     // 分xyz三个维度依次求出三个维度极值点
     for (int c = 0; c < 3; ++c) {
@@ -787,7 +798,7 @@ AABB3f AnimatedTransform::boundPointMotion(const Point3f& p) const {
         int nZeros = 0;
         // 找到对应维度的所有极值点
         intervalFindZeros(c1[c].Eval(p), c2[c].Eval(p), c3[c].Eval(p),
-            c4[c].Eval(p), c5[c].Eval(p), theta, Interval(0., 1.),
+            c4[c].Eval(p), c5[c].Eval(p), theta, Interval(u0, u1),
             zeros, &nZeros);
         CHECK_LE(nZeros, sizeof(zeros) / sizeof(zeros[0]));
 
@@ -184,6 +184,11 @@ public:
         return _startTransform->hasScale() || _endTransform->hasScale();
     }
 
+    // 没有旋转时点随时间线性运动
+    bool hasRotation() const {
+        return _actuallyAnimated && _hasRotation;
+    }
+
     const Transform* getStartTransform() const {
         return _startTransform;
     }
@@ -197,11 +202,21 @@ public:
      */
     AABB3f motionAABB(const AABB3f& b) const;
 
+    /**
+     * 同上，只考虑[time0, time1]时间段内扫过的范围
+     */
+    AABB3f motionAABB(const AABB3f& b, Float time0, Float time1) const;
+
     /**
      * 获取点对象，返回运动过程中点扫过的范围的包围盒
      */
     AABB3f boundPointMotion(const Point3f& p) const;
 
+    /**
+     * 同上，只考虑[time0, time1]时间段内扫过的范围
+     */
+    AABB3f boundPointMotion(const Point3f& p, Float time0, Float time1) const;
+
 private:
 
     const Transform* _startTransform;
@@ -30,7 +30,7 @@ Transform Quaternion::toTransform() const {
         1 - 2 * (yy + zz), 2 * (xy + wz),     2 * (xz - wy),     0,
         2 * (xy - wz),     1 - 2 * (xx + zz), 2 * (yz + wx),     0,
         2 * (xz + wy),     2 * (yz - wx),     1 - 2 * (xx + yy), 0,
-        0,                 0,                 0,                 0
+        0,                 0,                 0,                 1
     };
     Matrix4x4 mat(a);
     return Transform(mat.getTransposeMat(), mat);
@@ -150,12 +150,13 @@ bool Matrix4x4::operator < (const Matrix4x4& other) const {
 }
 
 bool Matrix4x4::operator != (const Matrix4x4& other) const {
+    // 任意一个元素不同即不相等
     for (int i = 0; i < 16; ++i) {
-        if (_a[i] == other._a[i]) {
-            return false;
+        if (_a[i] != other._a[i]) {
+            return true;
         }
     }
-    return true;
+    return false;
 }
 
 bool Matrix4x4::isIdentity() const {
@@ -1,16 +1,72 @@
 ﻿#include "Parallel.h"
 
+#include <deque>
+
 namespace Rendering
 {
+	// 需要执行的一段迭代区间
+	struct ParallelTask {
+		ParallelForLoop* loop;
+		int64_t indexStart;
+		int64_t indexEnd;
+	};
+
+	/**
+	 * 每个线程一个双端队列
+	 * 线程自己从尾部取任务（最新拆出来的小区间，缓存友好），
+	 * 其他线程从头部窃取（最早放进去的大区间），两端各自只在取任务时短暂上锁，
+	 * 不再有所有线程争抢的全局锁
+	 */
+	class TaskDeque {
+	public:
+		void push(const ParallelTask& task) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			_tasks.push_back(task);
+		}
+
+		// only不为空时只取属于该循环的任务
+		bool pop(ParallelTask& task, const ParallelForLoop* only) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			if (_tasks.empty() || (only && _tasks.back().loop != only)) {
+				return false;
+			}
+			task = _tasks.back();
+			_tasks.pop_back();
+			return true;
+		}
+
+		bool steal(ParallelTask& task, const ParallelForLoop* only) {
+			std::lock_guard<std::mutex> lock(_mutex);
+			for (auto iter = _tasks.begin(); iter != _tasks.end(); ++iter) {
+				if (!only || iter->loop == only) {
+					task = *iter;
+					_tasks.erase(iter);
+					return true;
+				}
+			}
+			return false;
+		}
+
+	private:
+		std::mutex _mutex;
+		std::deque<ParallelTask> _tasks;
+	};
+
 	// 线程列表
 	static std::vector<std::thread> threads;
 	// 
 	static bool shutdownThreads = false;
 
-	static ParallelForLoop* workList = nullptr;
-	static std::mutex workListMutex;
+	static std::unique_ptr<TaskDeque[]> taskDeques;
+	static int nTaskDeques = 0;
+	// 所有队列中的任务总数，空闲线程据此决定是否休眠
+	static std::atomic<int64_t> queuedTasks{ 0 };
+	static std::atomic<int> sleepingWorkers{ 0 };
+	static std::mutex workerMutex;
+	static std::condition_variable workerCondition;
 
 	static std::atomic<bool> reportWorkerStats{ false };
+	static int reportGeneration = 0;
 
 	static std::atomic<int> reporterCount;
 
@@ -19,112 +75,85 @@ namespace Rendering
 	static int nThread = 0;
 	thread_local int ThreadIndex = 0;
 
-	static std::condition_variable workListCondition;
-
 	int getCurThreadIndex() {
 		return ThreadIndex;
 	}
 
-	void parallelFor(std::function<void(int64_t)> func, int64_t count, int chunkSize) {
-		DCHECK(threads.size() > 0 || maxThreadIndex() == 1);
+	static TaskDeque& localTaskDeque() {
+		return taskDeques[ThreadIndex % nTaskDeques];
+	}
 
-		if (threads.empty() || count < chunkSize) {
-			for (int64_t i = 0; i < count; ++i) {
-				func(i);
+	static void pushTask(const ParallelTask& task, bool wakeAll) {
+		// 先增加计数再检查休眠线程数，与workerThreadFunc中的顺序相反，保证唤醒不会丢失
+		++queuedTasks;
+		localTaskDeque().push(task);
+		if (sleepingWorkers > 0) {
+			std::lock_guard<std::mutex> lock(workerMutex);
+			if (wakeAll) {
+				workerCondition.notify_all();
+			}
+			else {
+				workerCondition.notify_one();
 			}
-			return;
 		}
+	}
 
-		ParallelForLoop loop(std::move(func), count, chunkSize, CurrentProfilerState());
-		{
-			std::lock_guard<std::mutex> lock(workListMutex);
-			loop.next = workList;
-			workList = &loop;
+	static bool findTask(ParallelTask& task, const ParallelForLoop* only) {
+		int self = ThreadIndex % nTaskDeques;
+		if (taskDeques[self].pop(task, only)) {
+			--queuedTasks;
+			return true;
 		}
+		for (int i = 1; i < nTaskDeques; ++i) {
+			if (taskDeques[(self + i) % nTaskDeques].steal(task, only)) {
+				--queuedTasks;
+				return true;
+			}
+		}
+		return false;
+	}
 
-		std::unique_lock<std::mutex> lock(workListMutex);
-		workListCondition.notify_all();
-
-		while (!loop.finished()) {
-			int64_t indexStart = loop.nextIndex;
-			int64_t indexEnd = std::min(indexStart + loop.chunkSize, loop.maxIndex);
+	static void executeTask(ParallelTask task) {
+		ParallelForLoop& loop = *task.loop;
 
-			loop.nextIndex = indexEnd;
+		// 惰性二分，后半段留给自己稍后执行或者被其他线程窃取
+		while (task.indexEnd - task.indexStart > loop.chunkSize) {
+			int64_t indexMid = task.indexStart + (task.indexEnd - task.indexStart) / 2;
+			pushTask(ParallelTask{ &loop, indexMid, task.indexEnd }, false);
+			task.indexEnd = indexMid;
+		}
 
-			if (loop.nextIndex == loop.maxIndex) {
-				workList = loop.next;
-			}
+		uint64_t oldState = ProfilerState;
+		ProfilerState = loop.profilerState;
+		loop.runRange(loop.body, task.indexStart, task.indexEnd);
+		ProfilerState = oldState;
 
-			++loop.activeWorkers;
-			lock.unlock();
-			// 执行[indexStart, indexEnd)区间内的索引
-			for (int64_t index = indexStart; index < indexEnd; ++index) {
-				uint64_t oldState = ProfilerState;
-				ProfilerState = loop.profilerState;
-				if (loop.func1D) {
-					loop.func1D(index);
-				}
-				else {
-					loop.func2D(Point2i(index % loop.numX, index / loop.numX), 0);
-				}
-				ProfilerState = oldState;
-			}
-			lock.lock();
-			--loop.activeWorkers;
-		}
+		// 这是对loop的最后一次访问，计数归零后loop所在的栈帧随时可能被释放
+		loop.remaining -= task.indexEnd - task.indexStart;
 	}
 
-	void parallelFor2D(std::function<void(Point2i, int)> func, const Point2i& count) {
+	void runParallelForLoop(ParallelForLoop& loop) {
 		DCHECK(threads.size() > 0 || maxThreadIndex() == 1);
 
-		if (threads.empty() || count.x * count.y <= 1) {
-			for (int64_t y = 0; y < count.y; ++y) {
-				for (int64_t x = 0; x < count.x; ++x) {
-					func(Point2i(x, y), 0);
-				}
+		if (threads.empty() || loop.maxIndex <= loop.chunkSize) {
+			if (loop.maxIndex > 0) {
+				loop.runRange(loop.body, 0, loop.maxIndex);
 			}
 			return;
 		}
 
-		ParallelForLoop loop(std::move(func), count, CurrentProfilerState());
-		{
-			std::lock_guard<std::mutex> lock(workListMutex);
-			loop.next = workList;
-			workList = &loop;
-		}
+		pushTask(ParallelTask{ &loop, 0, loop.maxIndex }, true);
 
-		std::unique_lock<std::mutex> lock(workListMutex);
-		workListCondition.notify_all();
-
-		// 一直循环，直到所有线程都执行完毕之后才结束
-		// 保证了线程的同步
-		ThreadIndex = 0;
+		// 等待期间只执行属于这个循环的任务，
+		// 否则外层循环的循环体可能在同一线程上重入，破坏以ThreadIndex为下标的线程私有数据
 		while (!loop.finished()) {
-			int64_t indexStart = loop.nextIndex;
-			int64_t indexEnd = std::min(indexStart + loop.chunkSize, loop.maxIndex);
-
-			loop.nextIndex = indexEnd;
-
-			if (loop.nextIndex == loop.maxIndex) {
-				workList = loop.next;
+			ParallelTask task;
+			if (findTask(task, &loop)) {
+				executeTask(task);
 			}
-
-			++loop.activeWorkers;
-			lock.unlock();
-			// 执行[indexStart, indexEnd)区间内的索引
-			for (int64_t index = indexStart; index < indexEnd; ++index) {
-				uint64_t oldState = ProfilerState;
-				ProfilerState = loop.profilerState;
-				if (loop.func1D) {
-					loop.func1D(index);
-				}
-				else {
-					loop.func2D(Point2i(index % loop.numX, index / loop.numX), 0);
-				}
-				ProfilerState = oldState;
+			else {
+				std::this_thread::yield();
 			}
-			lock.lock();
-			--loop.activeWorkers;
 		}
 	}
 
@@ -139,53 +168,33 @@ namespace Rendering
 		//每个线程各自释放掉barrier对象
 		barrier.reset();
 
-		// 以下逻辑涉及线程同步问题，上锁
-		std::unique_lock<std::mutex> lock(workListMutex);
-		while (!shutdownThreads) {
-			if (reportWorkerStats) {
-				ReportThreadStats();
-				if (--reporterCount == 0) {
-					reportDoneCondition.notify_one();
-				}
-				workListCondition.wait(lock);
-			}
-			else if (!workList) {
-				// 如果没有任务需要执行，则等待
-				workListCondition.wait(lock);
+		int reportedGeneration = 0;
+		while (true) {
+			ParallelTask task;
+			if (findTask(task, nullptr)) {
+				executeTask(task);
+				continue;
 			}
-			else {
-				ParallelForLoop& loop = *workList;
-
-				int64_t indexStart = loop.nextIndex;
-				int64_t indexEnd = std::min(indexStart + loop.chunkSize, loop.maxIndex);
-
-				// 这个循环结束的索引就是下个循环的开始，
-				loop.nextIndex = indexEnd;
-				if (loop.nextIndex == loop.maxIndex) {
-					// 如果当前loop已经执行完毕，则执行下一个loop
-					workList = loop.next;
-				}
 
-				++loop.activeWorkers;
+			// 没有任务可以执行，休眠直到有新任务、需要汇报统计数据或者退出
+			std::unique_lock<std::mutex> lock(workerMutex);
+			++sleepingWorkers;
+			workerCondition.wait(lock, [&]() {
+				return shutdownThreads || queuedTasks > 0 ||
+					(reportWorkerStats && reportedGeneration != reportGeneration);
+				});
+			--sleepingWorkers;
+
+			if (shutdownThreads) {
+				return;
+			}
+			if (reportWorkerStats && reportedGeneration != reportGeneration) {
+				reportedGeneration = reportGeneration;
 				lock.unlock();
-				// 执行[indexStart, indexEnd)区间内的索引
-				for (int64_t index = indexStart; index < indexEnd; ++index) {
-					uint64_t oldState = ProfilerState;
-					ProfilerState = loop.profilerState;
-					if (loop.func1D) {
-						loop.func1D(index);
-					}
-					else {
-						loop.func2D(Point2i(index % loop.numX, index / loop.numX), ThreadIndex);
-					}
-					ProfilerState = oldState;
-				}
-				lock.lock();
-				--loop.activeWorkers;
-				if (loop.finished()) {
-					// 因为其他线程可能处于wait状态
-					// 如果loop执行完毕，则唤醒所有线程
-					workListCondition.notify_all();
+				ReportThreadStats();
+				if (--reporterCount == 0) {
+					std::lock_guard<std::mutex> doneLock(reportDoneMutex);
+					reportDoneCondition.notify_one();
 				}
 			}
 		}
@@ -209,6 +218,10 @@ namespace Rendering
 		int nThreads = maxThreadIndex();
 		ThreadIndex = 0;
 
+		nTaskDeques = nThreads;
+		taskDeques.reset(new TaskDeque[nTaskDeques]);
+		queuedTasks = 0;
+
 		std::shared_ptr<Barrier> barrier = std::make_shared<Barrier>(nThreads);
 
 		for (int i = 0; i < nThreads - 1; ++i) {
@@ -223,9 +236,9 @@ namespace Rendering
 			return;
 		}
 		{
-			std::lock_guard<std::mutex> lock(workListMutex);
+			std::lock_guard<std::mutex> lock(workerMutex);
 			shutdownThreads = true;
-			workListCondition.notify_all();
+			workerCondition.notify_all();
 		}
 		for (std::thread& thread : threads) {
 			thread.join();
@@ -235,18 +248,21 @@ namespace Rendering
 	}
 
 	void mergeWorkerThreadStats() {
-		std::unique_lock<std::mutex> lock(workListMutex);
-		std::unique_lock<std::mutex> doneLock(reportDoneMutex);
-		// Set up state so that the worker threads will know that we would like
-		// them to report their thread-specific stats when they wake up.
-		reportWorkerStats = true;
-		reporterCount = threads.size();
-
-		// Wake up the worker threads.
-		workListCondition.notify_all();
+		{
+			// Set up state so that the worker threads will know that we would like
+			// them to report their thread-specific stats when they wake up.
+			std::lock_guard<std::mutex> lock(workerMutex);
+			reporterCount = threads.size();
+			reportWorkerStats = true;
+			++reportGeneration;
+
+			// Wake up the worker threads.
+			workerCondition.notify_all();
+		}
 
 		// Wait for all of them to merge their stats.
-		reportDoneCondition.wait(lock, []() { return reporterCount == 0; });
+		std::unique_lock<std::mutex> doneLock(reportDoneMutex);
+		reportDoneCondition.wait(doneLock, []() { return reporterCount == 0; });
 
 		reportWorkerStats = false;
 	}
@@ -79,61 +79,74 @@ namespace Rendering
         int _count;
     };
 
+    /**
+     * 一个并行循环
+     * 循环体只在区间的粒度上做一次类型擦除的间接调用，区间内部直接调用内联的循环体，
+     * 避免每次迭代都经过std::function
+     */
     struct ParallelForLoop {
 
     public:
-        ParallelForLoop(std::function<void(int64_t)> func1D, int64_t maxIndex,
+        typedef void (*RangeFunc)(void* body, int64_t indexStart, int64_t indexEnd);
+
+        ParallelForLoop(RangeFunc runRange, void* body, int64_t maxIndex,
             int chunkSize, uint64_t profilerState)
-            : func1D(std::move(func1D)),
+            : runRange(runRange),
+            body(body),
             maxIndex(maxIndex),
-            chunkSize(chunkSize),
-            profilerState(profilerState) {
-
-        }
+            chunkSize(std::max(1, chunkSize)),
+            profilerState(profilerState),
+            remaining(maxIndex) {
 
-        ParallelForLoop(const std::function<void(Point2i, int)>& f, const Point2i& count,
-            uint64_t profilerState)
-            : func2D(f),
-            maxIndex(count.x* count.y),
-            chunkSize(1),
-            profilerState(profilerState) {
-            numX = count.x;
         }
 
     public:
-        // 一维变量函数
-        std::function<void(int64_t)> func1D;
-        // 二维变量函数
-        std::function<void(Point2i, int)> func2D;
+        // 执行[indexStart, indexEnd)区间内的索引
+        const RangeFunc runRange;
+        void* const body;
         // 最大迭代次数
         const int64_t maxIndex;
 
-        // 每次迭代的循环次数
-        // 把n个任务分成若干块，每块的大小为chunkSize
-        // 把n个任务分配给子线程也是按块分配
+        // 区间一直二分到不大于chunkSize为止，
+        // 被拆出来的后半段放进当前线程的队列，供其他线程窃取
         const int chunkSize;
 
         uint64_t profilerState;
-        // 下个迭代索引
-        int64_t nextIndex = 0;
-        // 当前激活worker线程
-        int activeWorkers = 0;
-
-        ParallelForLoop* next = nullptr;
-        // 二维函数需要用到的属性
-        int numX = -1;
+        // 尚未执行完毕的迭代次数，为0时循环结束
+        std::atomic<int64_t> remaining;
 
         bool finished() const {
-            return nextIndex >= maxIndex && activeWorkers == 0;
+            return remaining == 0;
         }
     };
 
     extern thread_local int ThreadIndex;
 
-    void parallelFor(std::function<void(int64_t)> func, int64_t count, int chunkSize = 1);
-
+    // 调用线程把loop放进自己的队列并参与执行，直到所有迭代执行完毕才返回，
+    // 在循环体内嵌套调用也是安全的
+    void runParallelForLoop(ParallelForLoop& loop);
+
+    template <typename Function>
+    void parallelFor(Function&& func, int64_t count, int chunkSize = 1) {
+        typedef typename std::remove_reference<Function>::type Body;
+        ParallelForLoop loop([](void* body, int64_t indexStart, int64_t indexEnd) {
+            Body& f = *static_cast<Body*>(body);
+            for (int64_t index = indexStart; index < indexEnd; ++index) {
+                f(index);
+            }
+            }, const_cast<void*>(static_cast<const void*>(&func)), count, chunkSize, CurrentProfilerState());
+        runParallelForLoop(loop);
+    }
 
-    void parallelFor2D(std::function<void(Point2i, int)> func, const Point2i& count);
+    // func的第二个参数为执行线程的ThreadIndex
+    template <typename Function>
+    void parallelFor2D(Function&& func, const Point2i& count) {
+        const int64_t numX = count.x;
+        auto body = [&func, numX](int64_t index) {
+            func(Point2i(index % numX, index / numX), ThreadIndex);
+        };
+        parallelFor(body, (int64_t)count.x * count.y, 1);
+    }
 
     inline int numSystemCores() {
         return std::max(1u, std::thread::hardware_concurrency());
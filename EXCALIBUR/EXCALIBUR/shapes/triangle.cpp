@@ -1 +1,324 @@
-﻿
\ No newline at end of file
+﻿#include "triangle.h"
+#include "../core/Sampling.h"
+
+RENDERING_BEGIN
+
+STAT_PERCENT("Intersections/Ray-triangle intersection tests", nHits, nTests);
+STAT_MEMORY_COUNTER("Memory/Triangle meshes", triMeshBytes);
+STAT_COUNTER("Scene/Triangles", nTris);
+
+TriangleMesh::TriangleMesh(const Transform& objectToWorld, int nTriangles,
+    const int* vertexIndices, int nVertices, const Point3f* P,
+    const Normal3f* N, const Point2f* UV)
+    : nTriangles(nTriangles),
+    nVertices(nVertices),
+    vertexIndices(vertexIndices, vertexIndices + 3 * nTriangles) {
+    // 顶点在构造时一次性变换到世界空间
+    this->P.reset(new Point3f[nVertices]);
+    for (int i = 0; i < nVertices; ++i) {
+        this->P[i] = objectToWorld.exec(P[i]);
+    }
+    if (N) {
+        this->N.reset(new Normal3f[nVertices]);
+        for (int i = 0; i < nVertices; ++i) {
+            this->N[i] = objectToWorld.exec(N[i]);
+        }
+    }
+    if (UV) {
+        this->UV.reset(new Point2f[nVertices]);
+        std::copy(UV, UV + nVertices, this->UV.get());
+    }
+    triMeshBytes += sizeof(*this) + this->vertexIndices.size() * sizeof(int) +
+        nVertices * (sizeof(*P) + (N ? sizeof(*N) : 0) + (UV ? sizeof(*UV) : 0));
+}
+
+std::vector<std::shared_ptr<Shape>> createTriangleMesh(
+    const Transform* objectToWorld, const Transform* worldToObject,
+    bool reverseOrientation, int nTriangles, const int* vertexIndices,
+    int nVertices, const Point3f* P, const Normal3f* N, const Point2f* UV) {
+    std::shared_ptr<TriangleMesh> mesh = std::make_shared<TriangleMesh>(
+        *objectToWorld, nTriangles, vertexIndices, nVertices, P, N, UV);
+    mesh->triangles.reserve(nTriangles);
+    for (int i = 0; i < nTriangles; ++i) {
+        mesh->triangles.emplace_back(objectToWorld, worldToObject,
+            reverseOrientation, mesh.get(), i);
+        mesh->triangles.back().init();
+    }
+    triMeshBytes += nTriangles * sizeof(Triangle);
+    nTris += nTriangles;
+    // 使用shared_ptr的别名构造函数，所有三角形共享网格的引用计数
+    // 每个三角形不再单独分配控制块
+    std::vector<std::shared_ptr<Shape>> tris;
+    tris.reserve(nTriangles);
+    for (int i = 0; i < nTriangles; ++i) {
+        tris.push_back(std::shared_ptr<Shape>(mesh, &mesh->triangles[i]));
+    }
+    return tris;
+}
+
+const int* Triangle::vertices() const {
+    return &_mesh->vertexIndices[3 * _triNumber];
+}
+
+void Triangle::getUVs(Point2f uv[3]) const {
+    if (_mesh->UV) {
+        const int* v = vertices();
+        uv[0] = _mesh->UV[v[0]];
+        uv[1] = _mesh->UV[v[1]];
+        uv[2] = _mesh->UV[v[2]];
+    } else {
+        uv[0] = Point2f(0, 0);
+        uv[1] = Point2f(1, 0);
+        uv[2] = Point2f(1, 1);
+    }
+}
+
+AABB3f Triangle::objectBound() const {
+    const int* v = vertices();
+    const Point3f& p0 = _mesh->P[v[0]];
+    const Point3f& p1 = _mesh->P[v[1]];
+    const Point3f& p2 = _mesh->P[v[2]];
+    return unionSet(AABB3f(worldToObject->exec(p0), worldToObject->exec(p1)),
+        worldToObject->exec(p2));
+}
+
+AABB3f Triangle::worldBound() const {
+    // 顶点已经在世界空间中，不需要再变换包围盒
+    const int* v = vertices();
+    const Point3f& p0 = _mesh->P[v[0]];
+    const Point3f& p1 = _mesh->P[v[1]];
+    const Point3f& p2 = _mesh->P[v[2]];
+    return unionSet(AABB3f(p0, p1), p2);
+}
+
+Float Triangle::area() const {
+    const int* v = vertices();
+    const Point3f& p0 = _mesh->P[v[0]];
+    const Point3f& p1 = _mesh->P[v[1]];
+    const Point3f& p2 = _mesh->P[v[2]];
+    return 0.5 * cross(p1 - p0, p2 - p0).length();
+}
+
+bool Triangle::intersect(const Ray& ray, Float* tHit, SurfaceInteraction* isect,
+    bool testAlphaTexture) const {
+    ProfilePhase p(isect ? Prof::TriRayIntersect : Prof::TriRayOccluded);
+    ++nTests;
+    const int* v = vertices();
+    const Point3f& p0 = _mesh->P[v[0]];
+    const Point3f& p1 = _mesh->P[v[1]];
+    const Point3f& p2 = _mesh->P[v[2]];
+
+    // 水密求交，先把三角形顶点变换到射线坐标系中
+    // 射线起点为原点，射线方向为+z轴
+    Point3f p0t = p0 - Vector3f(ray.ori);
+    Point3f p1t = p1 - Vector3f(ray.ori);
+    Point3f p2t = p2 - Vector3f(ray.ori);
+
+    // 把射线方向分量绝对值最大的维度置换到z轴
+    int kz = maxDimension(abs(ray.dir));
+    int kx = kz + 1;
+    if (kx == 3) {
+        kx = 0;
+    }
+    int ky = kx + 1;
+    if (ky == 3) {
+        ky = 0;
+    }
+    Vector3f d = permute(ray.dir, kx, ky, kz);
+    p0t = permute(p0t, kx, ky, kz);
+    p1t = permute(p1t, kx, ky, kz);
+    p2t = permute(p2t, kx, ky, kz);
+
+    // 错切变换，z分量延后到确定相交之后再计算
+    Float Sx = -d.x / d.z;
+    Float Sy = -d.y / d.z;
+    Float Sz = 1.f / d.z;
+    p0t.x += Sx * p0t.z;
+    p0t.y += Sy * p0t.z;
+    p1t.x += Sx * p1t.z;
+    p1t.y += Sy * p1t.z;
+    p2t.x += Sx * p2t.z;
+    p2t.y += Sy * p2t.z;
+
+    // 边函数
+    Float e0 = p1t.x * p2t.y - p1t.y * p2t.x;
+    Float e1 = p2t.x * p0t.y - p2t.y * p0t.x;
+    Float e2 = p0t.x * p1t.y - p0t.y * p1t.x;
+
+    // 射线恰好经过边上时，用双精度重新计算
+    if (sizeof(Float) == sizeof(float) &&
+        (e0 == 0.0f || e1 == 0.0f || e2 == 0.0f)) {
+        double p2txp1ty = (double)p2t.x * (double)p1t.y;
+        double p2typ1tx = (double)p2t.y * (double)p1t.x;
+        e0 = (float)(p2typ1tx - p2txp1ty);
+        double p0txp2ty = (double)p0t.x * (double)p2t.y;
+        double p0typ2tx = (double)p0t.y * (double)p2t.x;
+        e1 = (float)(p0typ2tx - p0txp2ty);
+        double p1txp0ty = (double)p1t.x * (double)p0t.y;
+        double p1typ0tx = (double)p1t.y * (double)p0t.x;
+        e2 = (float)(p1typ0tx - p1txp0ty);
+    }
+
+    if ((e0 < 0 || e1 < 0 || e2 < 0) && (e0 > 0 || e1 > 0 || e2 > 0)) {
+        return false;
+    }
+    Float det = e0 + e1 + e2;
+    if (det == 0) {
+        return false;
+    }
+
+    // 计算缩放过的t值，避免除法
+    p0t.z *= Sz;
+    p1t.z *= Sz;
+    p2t.z *= Sz;
+    Float tScaled = e0 * p0t.z + e1 * p1t.z + e2 * p2t.z;
+    if (det < 0 && (tScaled >= 0 || tScaled < ray.tMax * det)) {
+        return false;
+    } else if (det > 0 && (tScaled <= 0 || tScaled > ray.tMax * det)) {
+        return false;
+    }
+
+    Float invDet = 1 / det;
+    Float b0 = e0 * invDet;
+    Float b1 = e1 * invDet;
+    Float b2 = e2 * invDet;
+    Float t = tScaled * invDet;
+
+    // 保守地保证t大于零，误差分析见pbrt 3.9.6
+    Float maxZt = maxComponent(abs(Vector3f(p0t.z, p1t.z, p2t.z)));
+    Float deltaZ = gamma(3) * maxZt;
+
+    Float maxXt = maxComponent(abs(Vector3f(p0t.x, p1t.x, p2t.x)));
+    Float maxYt = maxComponent(abs(Vector3f(p0t.y, p1t.y, p2t.y)));
+    Float deltaX = gamma(5) * (maxXt + maxZt);
+    Float deltaY = gamma(5) * (maxYt + maxZt);
+
+    Float deltaE = 2 * (gamma(2) * maxXt * maxYt + deltaY * maxXt + deltaX * maxYt);
+
+    Float maxE = maxComponent(abs(Vector3f(e0, e1, e2)));
+    Float deltaT = 3 *
+        (gamma(3) * maxE * maxZt + deltaE * maxZt + deltaZ * maxE) *
+        std::abs(invDet);
+    if (t <= deltaT) {
+        return false;
+    }
+
+    if (isect == nullptr) {
+        ++nHits;
+        return true;
+    }
+
+    // 计算三角形的偏导数
+    Vector3f dpdu, dpdv;
+    Point2f uv[3];
+    getUVs(uv);
+
+    Vector2f duv02 = uv[0] - uv[2], duv12 = uv[1] - uv[2];
+    Vector3f dp02 = p0 - p2, dp12 = p1 - p2;
+    Float determinant = duv02[0] * duv12[1] - duv02[1] * duv12[0];
+    bool degenerateUV = std::abs(determinant) < 1e-8;
+    if (!degenerateUV) {
+        Float invdet = 1 / determinant;
+        dpdu = (duv12[1] * dp02 - duv02[1] * dp12) * invdet;
+        dpdv = (-duv12[0] * dp02 + duv02[0] * dp12) * invdet;
+    }
+    if (degenerateUV || cross(dpdu, dpdv).lengthSquared() == 0) {
+        Vector3f ng = cross(p2 - p0, p1 - p0);
+        if (ng.lengthSquared() == 0) {
+            // 退化三角形
+            return false;
+        }
+        coordinateSystem(normalize(ng), &dpdu, &dpdv);
+    }
+
+    // 用重心坐标插值交点，误差为gamma(7)
+    Float xAbsSum = (std::abs(b0 * p0.x) + std::abs(b1 * p1.x) + std::abs(b2 * p2.x));
+    Float yAbsSum = (std::abs(b0 * p0.y) + std::abs(b1 * p1.y) + std::abs(b2 * p2.y));
+    Float zAbsSum = (std::abs(b0 * p0.z) + std::abs(b1 * p1.z) + std::abs(b2 * p2.z));
+    Vector3f pError = gamma(7) * Vector3f(xAbsSum, yAbsSum, zAbsSum);
+    Point3f pHit = b0 * p0 + b1 * p1 + b2 * p2;
+    Point2f uvHit = b0 * uv[0] + b1 * uv[1] + b2 * uv[2];
+
+    // 顶点已经在世界空间，不需要再用objectToWorld变换交点
+    *isect = SurfaceInteraction(pHit, pError, uvHit, -ray.dir, dpdu, dpdv,
+        Normal3f(0, 0, 0), Normal3f(0, 0, 0), ray.time, this, _triNumber);
+
+    // 几何法线由三角形的边决定
+    isect->normal = isect->shading.normal = Normal3f(normalize(cross(dp02, dp12)));
+    if (reverseOrientation ^ transformSwapsHandedness) {
+        isect->normal = isect->shading.normal = -isect->normal;
+    }
+
+    if (_mesh->N) {
+        // 有顶点法线时，用插值后的法线作为着色法线
+        Normal3f ns = b0 * _mesh->N[v[0]] + b1 * _mesh->N[v[1]] + b2 * _mesh->N[v[2]];
+        if (ns.lengthSquared() > 0) {
+            ns = normalize(ns);
+            Vector3f ss = normalize(isect->dpdu);
+            Vector3f ts = cross(Vector3f(ns), ss);
+            if (ts.lengthSquared() > 0) {
+                ts = normalize(ts);
+                ss = cross(ts, Vector3f(ns));
+            } else {
+                coordinateSystem(Vector3f(ns), &ss, &ts);
+            }
+            isect->setShadingGeometry(ss, ts, Normal3f(0, 0, 0), Normal3f(0, 0, 0), true);
+        }
+    }
+    *tHit = t;
+    ++nHits;
+    return true;
+}
+
+bool Triangle::intersectP(const Ray& ray, bool testAlphaTexture) const {
+    return intersect(ray, nullptr, nullptr, testAlphaTexture);
+}
+
+Interaction Triangle::sampleA(const Point2f& u, Float* pdf) const {
+    const int* v = vertices();
+    const Point3f& p0 = _mesh->P[v[0]];
+    const Point3f& p1 = _mesh->P[v[1]];
+    const Point3f& p2 = _mesh->P[v[2]];
+    Point2f b = uniformSampleTriangle(u);
+    Interaction ret;
+    ret.pos = b[0] * p0 + b[1] * p1 + (1 - b[0] - b[1]) * p2;
+    ret.normal = normalize(Normal3f(cross(p1 - p0, p2 - p0)));
+    if (_mesh->N) {
+        Normal3f ns(b[0] * _mesh->N[v[0]] + b[1] * _mesh->N[v[1]] +
+            (1 - b[0] - b[1]) * _mesh->N[v[2]]);
+        ret.normal = faceforward(ret.normal, ns);
+    } else if (reverseOrientation ^ transformSwapsHandedness) {
+        ret.normal *= -1;
+    }
+    Point3f pAbsSum = abs(b[0] * p0) + abs(b[1] * p1) + abs((1 - b[0] - b[1]) * p2);
+    ret.pError = gamma(6) * Vector3f(pAbsSum.x, pAbsSum.y, pAbsSum.z);
+    *pdf = pdfA(ret);
+    return ret;
+}
+
+Float Triangle::solidAngle(const Point3f& p, int nSamples) const {
+    const int* v = vertices();
+    // 把三个顶点投影到以p为中心的单位球上，用Girard定理求球面三角形面积
+    Vector3f pSphere[3] = {
+        normalize(_mesh->P[v[0]] - p),
+        normalize(_mesh->P[v[1]] - p),
+        normalize(_mesh->P[v[2]] - p)
+    };
+    Vector3f cross01 = cross(pSphere[0], pSphere[1]);
+    Vector3f cross12 = cross(pSphere[1], pSphere[2]);
+    Vector3f cross20 = cross(pSphere[2], pSphere[0]);
+    if (cross01.lengthSquared() > 0) {
+        cross01 = normalize(cross01);
+    }
+    if (cross12.lengthSquared() > 0) {
+        cross12 = normalize(cross12);
+    }
+    if (cross20.lengthSquared() > 0) {
+        cross20 = normalize(cross20);
+    }
+    return std::abs(std::acos(clamp(dot(cross01, -cross12), -1, 1)) +
+        std::acos(clamp(dot(cross12, -cross20), -1, 1)) +
+        std::acos(clamp(dot(cross20, -cross01), -1, 1)) - Pi);
+}
+
+RENDERING_END
\ No newline at end of file
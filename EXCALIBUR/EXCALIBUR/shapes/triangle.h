@@ -1 +1,83 @@
-﻿
\ No newline at end of file
+﻿#ifndef triangle_hpp
+#define triangle_hpp
+
+#include "../core/header.h"
+#include "../core/Shape.h"
+#include <vector>
+
+RENDERING_BEGIN
+
+struct TriangleMesh;
+
+// 轻量级三角形，只保存所属网格的指针以及三角形的序号
+// 顶点数据全部存放在TriangleMesh的连续数组中
+class Triangle : public Shape {
+public:
+
+    Triangle(const Transform* objectToWorld, const Transform* worldToObject,
+        bool reverseOrientation, const TriangleMesh* mesh, int triNumber)
+        : Shape(objectToWorld, worldToObject, reverseOrientation),
+        _mesh(mesh),
+        _triNumber(triNumber) {
+
+    }
+
+    virtual void init() {
+        _invArea = 1 / area();
+    }
+
+    virtual AABB3f objectBound() const;
+
+    virtual AABB3f worldBound() const;
+
+    virtual bool intersect(const Ray& ray, Float* tHit, SurfaceInteraction* isect,
+        bool testAlphaTexture = true) const;
+
+    virtual bool intersectP(const Ray& ray, bool testAlphaTexture = true) const;
+
+    virtual Float area() const;
+
+    virtual Interaction sampleA(const Point2f& u, Float* pdf) const;
+
+    virtual Float solidAngle(const Point3f& p, int nSamples = 512) const;
+
+private:
+
+    // 返回三角形三个顶点在网格数组中的索引
+    const int* vertices() const;
+
+    void getUVs(Point2f uv[3]) const;
+
+    const TriangleMesh* _mesh;
+    const int _triNumber;
+};
+
+/*
+ 三角形网格，顶点位置，法线，uv以及索引都存放在连续的数组中
+ 构造时一次性把顶点变换到世界空间，求交时不再需要变换射线
+ 所有的Triangle也连续存放在网格中，避免每个三角形单独分配内存
+ */
+struct TriangleMesh {
+
+    TriangleMesh(const Transform& objectToWorld, int nTriangles,
+        const int* vertexIndices, int nVertices, const Point3f* P,
+        const Normal3f* N, const Point2f* UV);
+
+    const int nTriangles;
+    const int nVertices;
+    std::vector<int> vertexIndices;
+    std::unique_ptr<Point3f[]> P;
+    std::unique_ptr<Normal3f[]> N;
+    std::unique_ptr<Point2f[]> UV;
+    std::vector<Triangle> triangles;
+};
+
+// 创建网格以及其中所有的三角形，返回的shape与网格共享引用计数
+std::vector<std::shared_ptr<Shape>> createTriangleMesh(
+    const Transform* objectToWorld, const Transform* worldToObject,
+    bool reverseOrientation, int nTriangles, const int* vertexIndices,
+    int nVertices, const Point3f* P, const Normal3f* N, const Point2f* UV);
+
+RENDERING_END
+
+#endif /* triangle_hpp */
\ No newline at end of file
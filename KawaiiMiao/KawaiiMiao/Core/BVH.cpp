@@ -0,0 +1,1195 @@
+#include "BVH.h"
+
+#include "Interaction.h"
+#include "../Tool/Memory.h"
+
+#include <chrono>
+#include <algorithm>
+#include <immintrin.h>
+#include <tbb/tbb/parallel_for.h>
+
+RENDER_BEGIN
+
+struct BVHHitableInfo
+{
+	BVHHitableInfo() = default;
+	BVHHitableInfo(size_t hitableNumber, const Bounds3f& bounds)
+		: hitableNumber(hitableNumber), bounds(bounds),
+		centroid(0.5f * bounds.m_pMin + 0.5f * bounds.m_pMax) {}
+
+	size_t hitableNumber;
+	Bounds3f bounds;
+	Vector3f centroid;
+};
+
+struct BVHBuildNode
+{
+	void initLeaf(int first, int n, const Bounds3f& b)
+	{
+		firstHitableOffset = first;
+		nHitables = n;
+		bounds = b;
+		children[0] = children[1] = nullptr;
+	}
+
+	void initInterior(int axis, BVHBuildNode* c0, BVHBuildNode* c1)
+	{
+		children[0] = c0;
+		children[1] = c1;
+		bounds = unionBounds(c0->bounds, c1->bounds);
+		splitAxis = axis;
+		nHitables = 0;
+	}
+
+	Bounds3f bounds;
+	BVHBuildNode* children[2];
+	int splitAxis, firstHitableOffset, nHitables;
+};
+
+struct BVHBucketInfo
+{
+	int count = 0;
+	Bounds3f bounds;
+};
+
+//Note: returns the hit mask of the N children and writes their entry distances
+//      to _tEnter_. Exit distances are scaled by 1 + 2 * gamma(3) as in Bounds3::hit.
+template <int N>
+static inline int hitChildren(const WideBVHNode<N>& node, const float org[3], const float invDir[3],
+	const int dirIsNeg[3], float tMax, float tEnter[N])
+{
+	const float errScale = 1 + 2 * gamma(3);
+#ifdef __AVX__
+	if (N == 8)
+	{
+		__m256 t0 = _mm256_setzero_ps();
+		__m256 t1 = _mm256_set1_ps(tMax);
+		for (int a = 0; a < 3; ++a)
+		{
+			const float* nearB = dirIsNeg[a] ? node.bMax[a] : node.bMin[a];
+			const float* farB = dirIsNeg[a] ? node.bMin[a] : node.bMax[a];
+			__m256 o = _mm256_set1_ps(org[a]);
+			__m256 inv = _mm256_set1_ps(invDir[a]);
+			__m256 tNear = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(nearB), o), inv);
+			__m256 tFar = _mm256_mul_ps(_mm256_sub_ps(_mm256_load_ps(farB), o), inv);
+			//Note: the accumulator is the second operand so NaNs from 0 * inf are dropped
+			t0 = _mm256_max_ps(tNear, t0);
+			t1 = _mm256_min_ps(_mm256_mul_ps(tFar, _mm256_set1_ps(errScale)), t1);
+		}
+		_mm256_storeu_ps(tEnter, t0);
+		return _mm256_movemask_ps(_mm256_cmp_ps(t0, t1, _CMP_LE_OQ));
+	}
+#endif
+	int mask = 0;
+	for (int g = 0; g < N; g += 4)
+	{
+		__m128 t0 = _mm_setzero_ps();
+		__m128 t1 = _mm_set1_ps(tMax);
+		for (int a = 0; a < 3; ++a)
+		{
+			const float* nearB = dirIsNeg[a] ? node.bMax[a] : node.bMin[a];
+			const float* farB = dirIsNeg[a] ? node.bMin[a] : node.bMax[a];
+			__m128 o = _mm_set1_ps(org[a]);
+			__m128 inv = _mm_set1_ps(invDir[a]);
+			__m128 tNear = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(nearB + g), o), inv);
+			__m128 tFar = _mm_mul_ps(_mm_sub_ps(_mm_load_ps(farB + g), o), inv);
+			t0 = _mm_max_ps(tNear, t0);
+			t1 = _mm_min_ps(_mm_mul_ps(tFar, _mm_set1_ps(errScale)), t1);
+		}
+		_mm_storeu_ps(tEnter + g, t0);
+		mask |= _mm_movemask_ps(_mm_cmple_ps(t0, t1)) << g;
+	}
+	return mask;
+}
+
+//Note: grid step 2^exponent, built from the exponent bits directly
+static inline float quantizedStep(int exponent)
+{
+	return bitsToFloat(uint32_t(exponent + 127) << 23);
+}
+
+//Note: widens four 8-bit grid coordinates to floats
+static inline __m128 loadQuantized4(const uint8_t* q)
+{
+	int32_t bytes;
+	memcpy(&bytes, q, sizeof(int32_t));
+	const __m128i zero = _mm_setzero_si128();
+	__m128i words = _mm_unpacklo_epi8(_mm_cvtsi32_si128(bytes), zero);
+	return _mm_cvtepi32_ps(_mm_unpacklo_epi16(words, zero));
+}
+
+//Note: same slab test as above on the decoded child bounds origin + q * step, unused
+//      slots are dropped by the child mask.
+template <int N>
+static inline int hitChildren(const QuantizedBVHNode<N>& node, const float org[3], const float invDir[3],
+	const int dirIsNeg[3], float tMax, float tEnter[N])
+{
+	const float errScale = 1 + 2 * gamma(3);
+#ifdef __AVX__
+	if (N == 8)
+	{
+		__m256 t0 = _mm256_setzero_ps();
+		__m256 t1 = _mm256_set1_ps(tMax);
+		for (int a = 0; a < 3; ++a)
+		{
+			const uint8_t* nearQ = dirIsNeg[a] ? node.qMax[a] : node.qMin[a];
+			const uint8_t* farQ = dirIsNeg[a] ? node.qMin[a] : node.qMax[a];
+			__m256 origin = _mm256_set1_ps(node.origin[a]);
+			__m256 step = _mm256_set1_ps(quantizedStep(node.stepExponent[a]));
+			__m256 qNear = _mm256_insertf128_ps(_mm256_castps128_ps256(loadQuantized4(nearQ)),
+				loadQuantized4(nearQ + 4), 1);
+			__m256 qFar = _mm256_insertf128_ps(_mm256_castps128_ps256(loadQuantized4(farQ)),
+				loadQuantized4(farQ + 4), 1);
+			__m256 o = _mm256_set1_ps(org[a]);
+			__m256 inv = _mm256_set1_ps(invDir[a]);
+			__m256 nearB = _mm256_add_ps(origin, _mm256_mul_ps(qNear, step));
+			__m256 farB = _mm256_add_ps(origin, _mm256_mul_ps(qFar, step));
+			__m256 tNear = _mm256_mul_ps(_mm256_sub_ps(nearB, o), inv);
+			__m256 tFar = _mm256_mul_ps(_mm256_sub_ps(farB, o), inv);
+			t0 = _mm256_max_ps(tNear, t0);
+			t1 = _mm256_min_ps(_mm256_mul_ps(tFar, _mm256_set1_ps(errScale)), t1);
+		}
+		_mm256_storeu_ps(tEnter, t0);
+		return _mm256_movemask_ps(_mm256_cmp_ps(t0, t1, _CMP_LE_OQ)) & node.childMask;
+	}
+#endif
+	int mask = 0;
+	for (int g = 0; g < N; g += 4)
+	{
+		__m128 t0 = _mm_setzero_ps();
+		__m128 t1 = _mm_set1_ps(tMax);
+		for (int a = 0; a < 3; ++a)
+		{
+			const uint8_t* nearQ = dirIsNeg[a] ? node.qMax[a] : node.qMin[a];
+			const uint8_t* farQ = dirIsNeg[a] ? node.qMin[a] : node.qMax[a];
+			__m128 origin = _mm_set1_ps(node.origin[a]);
+			__m128 step = _mm_set1_ps(quantizedStep(node.stepExponent[a]));
+			__m128 o = _mm_set1_ps(org[a]);
+			__m128 inv = _mm_set1_ps(invDir[a]);
+			__m128 nearB = _mm_add_ps(origin, _mm_mul_ps(loadQuantized4(nearQ + g), step));
+			__m128 farB = _mm_add_ps(origin, _mm_mul_ps(loadQuantized4(farQ + g), step));
+			__m128 tNear = _mm_mul_ps(_mm_sub_ps(nearB, o), inv);
+			__m128 tFar = _mm_mul_ps(_mm_sub_ps(farB, o), inv);
+			t0 = _mm_max_ps(tNear, t0);
+			t1 = _mm_min_ps(_mm_mul_ps(tFar, _mm_set1_ps(errScale)), t1);
+		}
+		_mm_storeu_ps(tEnter + g, t0);
+		mask |= _mm_movemask_ps(_mm_cmple_ps(t0, t1)) << g;
+	}
+	return mask & node.childMask;
+}
+
+template <int N>
+static void setChildBounds(WideBVHNode<N>& wideNode, BVHBuildNode* const* children, int nChildren)
+{
+	// Empty slots get inverted bounds so that no ray can hit them
+	for (int i = 0; i < N; ++i)
+	{
+		for (int a = 0; a < 3; ++a)
+		{
+			wideNode.bMin[a][i] = i < nChildren ? float(children[i]->bounds.m_pMin[a]) : Infinity;
+			wideNode.bMax[a][i] = i < nChildren ? float(children[i]->bounds.m_pMax[a]) : -Infinity;
+		}
+	}
+}
+
+template <int N>
+static void setChildBounds(QuantizedBVHNode<N>& wideNode, BVHBuildNode* const* children, int nChildren)
+{
+	Bounds3f bounds;
+	for (int i = 0; i < nChildren; ++i)
+		bounds = unionBounds(bounds, children[i]->bounds);
+
+	wideNode.childMask = uint8_t((1 << nChildren) - 1);
+	for (int a = 0; a < 3; ++a)
+	{
+		const float origin = float(bounds.m_pMin[a]);
+		const float extent = float(bounds.m_pMax[a]) - origin;
+		wideNode.origin[a] = origin;
+
+		// Smallest power of two step that spans the node in 255 steps, grown by one
+		// whenever rounding pushes a decoded upper bound below its child
+		int exponent = extent > 0 ? (int)std::ceil(std::log2(extent / 255.f)) : -126;
+		exponent = glm::clamp(exponent, -126, 127);
+		while (true)
+		{
+			const float step = quantizedStep(exponent);
+			bool fits = true;
+			for (int i = 0; i < N; ++i)
+			{
+				int q0 = 0, q1 = 0;
+				if (i < nChildren)
+				{
+					const float cMin = float(children[i]->bounds.m_pMin[a]);
+					const float cMax = float(children[i]->bounds.m_pMax[a]);
+					q0 = (int)glm::clamp(std::floor((cMin - origin) / step), 0.f, 255.f);
+					q1 = (int)glm::clamp(std::ceil((cMax - origin) / step), 0.f, 255.f);
+
+					//Note: q * step is exact, origin + q * step matches the decoder bit for bit
+					while (q0 > 0 && origin + float(q0) * step > cMin)
+						--q0;
+					while (q1 < 255 && origin + float(q1) * step < cMax)
+						++q1;
+					if (origin + float(q1) * step < cMax)
+					{
+						fits = false;
+						break;
+					}
+				}
+				wideNode.qMin[a][i] = uint8_t(q0);
+				wideNode.qMax[a][i] = uint8_t(q1);
+			}
+			if (fits || exponent == 127)
+				break;
+			++exponent;
+		}
+		wideNode.stepExponent[a] = int8_t(exponent);
+	}
+}
+
+//Note: _child_ holds node offsets for interior slots, hitables offsets for leaf slots
+//      and -1 for empty slots, _nHitables_ is 0 for interior and empty slots.
+template <int N>
+static void setChildLinks(WideBVHNode<N>& wideNode, const int32_t child[N], const uint16_t nHitables[N])
+{
+	for (int i = 0; i < N; ++i)
+	{
+		wideNode.child[i] = child[i];
+		wideNode.nHitables[i] = nHitables[i];
+	}
+}
+
+template <int N>
+static void setChildLinks(QuantizedBVHNode<N>& wideNode, const int32_t child[N], const uint16_t nHitables[N])
+{
+	wideNode.childBase = -1;
+	wideNode.hitableBase = -1;
+	for (int i = 0; i < N; ++i)
+	{
+		CHECK_LT(nHitables[i], 256);
+		wideNode.nHitables[i] = uint8_t(nHitables[i]);
+		if (child[i] < 0)
+			continue;
+		int32_t& base = nHitables[i] > 0 ? wideNode.hitableBase : wideNode.childBase;
+		if (base < 0)
+			base = child[i];
+	}
+}
+
+template <int N>
+static inline void getChildLinks(const WideBVHNode<N>& wideNode, int32_t child[N], uint16_t nHitables[N])
+{
+	for (int i = 0; i < N; ++i)
+	{
+		child[i] = wideNode.child[i];
+		nHitables[i] = wideNode.nHitables[i];
+	}
+}
+
+template <int N>
+static inline void getChildLinks(const QuantizedBVHNode<N>& wideNode, int32_t child[N], uint16_t nHitables[N])
+{
+	int32_t nextChild = wideNode.childBase;
+	int32_t nextHitable = wideNode.hitableBase;
+	for (int i = 0; i < N; ++i)
+	{
+		nHitables[i] = wideNode.nHitables[i];
+		if (!(wideNode.childMask & (1 << i)))
+		{
+			child[i] = -1;
+		}
+		else if (nHitables[i] > 0)
+		{
+			child[i] = nextHitable;
+			nextHitable += nHitables[i];
+		}
+		else
+		{
+			child[i] = nextChild++;
+		}
+	}
+}
+
+static std::vector<Hitable::ptr> appendMeshTriangles(std::vector<Hitable::ptr> hitables,
+	const std::vector<TriangleMesh::ptr>& meshes)
+{
+	size_t nTriangles = 0;
+	for (const auto& mesh : meshes)
+		nTriangles += mesh->getTriangleCount();
+	hitables.reserve(hitables.size() + nTriangles);
+	for (const auto& mesh : meshes)
+		TriangleMesh::createTriangles(mesh, hitables);
+	return hitables;
+}
+
+HitableBVH::HitableBVH(std::vector<Hitable::ptr> hitables, const std::vector<TriangleMesh::ptr>& meshes,
+	int maxHitablesInNode, BVHLayout layout)
+	: HitableBVH(appendMeshTriangles(std::move(hitables), meshes), maxHitablesInNode, layout) {}
+
+HitableBVH::HitableBVH(std::vector<Hitable::ptr> hitables, int maxHitablesInNode, BVHLayout layout)
+	: m_maxHitablesInNode(glm::min(255, maxHitablesInNode)), m_layout(layout), m_hitables(std::move(hitables))
+{
+	if (m_hitables.empty())
+		return;
+
+	auto startTime = std::chrono::system_clock::now();
+
+	// Initialize _hitableInfo_ array for hitables
+	std::vector<BVHHitableInfo> hitableInfo(m_hitables.size());
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, m_hitables.size()),
+		[&](const tbb::blocked_range<size_t>& range)
+	{
+		for (size_t i = range.begin(); i != range.end(); ++i)
+			hitableInfo[i] = { i, m_hitables[i]->worldBound() };
+	});
+
+	// Build BVH tree for hitables using _hitableInfo_
+	MemoryArena arena(1024 * 1024);
+	int totalNodes = 0;
+	std::vector<Hitable::ptr> orderedHitables;
+	orderedHitables.reserve(m_hitables.size());
+	BVHBuildNode* root = recursiveBuild(arena, hitableInfo, 0, m_hitables.size(),
+		totalNodes, orderedHitables);
+	m_hitables.swap(orderedHitables);
+	hitableInfo.resize(0);
+
+	m_worldBound = root->bounds;
+
+	int offset = 0;
+	size_t treeBytes = 0;
+	if (m_layout == BVHLayout::Binary)
+	{
+		// Compute representation of depth-first traversal of BVH tree
+		m_nodes = AllocAligned<LinearBVHNode>(totalNodes);
+		flattenBVHTree(root, offset);
+		CHECK_EQ(totalNodes, offset);
+		treeBytes = offset * sizeof(LinearBVHNode);
+		m_totalNodes = offset;
+
+		// Repack leaves made of triangles only into SIMD triangle blocks
+		if (m_maxHitablesInNode >= 8)
+			treeBytes += packTriangleBlocks(m_blocks8) * sizeof(TriangleBlock<8>);
+		else
+			treeBytes += packTriangleBlocks(m_blocks4) * sizeof(TriangleBlock<4>);
+	}
+	else
+	{
+		//Note: every wide node consumes at least one interior node of the binary tree. The
+		//      collapse regroups the hitables so that the leaves of a node are consecutive.
+		int maxWideNodes = glm::max(1, (totalNodes - 1) / 2);
+		orderedHitables.clear();
+		offset = 1;
+		if (m_layout == BVHLayout::BVH4)
+		{
+			m_nodes4 = AllocAligned<WideBVHNode<4>>(maxWideNodes);
+			collapseWideBVH(root, m_nodes4, 0, offset, orderedHitables);
+			treeBytes = offset * sizeof(WideBVHNode<4>);
+		}
+		else if (m_layout == BVHLayout::BVH8)
+		{
+			m_nodes8 = AllocAligned<WideBVHNode<8>>(maxWideNodes);
+			collapseWideBVH(root, m_nodes8, 0, offset, orderedHitables);
+			treeBytes = offset * sizeof(WideBVHNode<8>);
+		}
+		else if (m_layout == BVHLayout::QuantizedBVH4)
+		{
+			m_qnodes4 = AllocAligned<QuantizedBVHNode<4>>(maxWideNodes);
+			collapseWideBVH(root, m_qnodes4, 0, offset, orderedHitables);
+			treeBytes = offset * sizeof(QuantizedBVHNode<4>);
+		}
+		else
+		{
+			m_qnodes8 = AllocAligned<QuantizedBVHNode<8>>(maxWideNodes);
+			collapseWideBVH(root, m_qnodes8, 0, offset, orderedHitables);
+			treeBytes = offset * sizeof(QuantizedBVHNode<8>);
+		}
+		CHECK_LE(offset, maxWideNodes);
+		CHECK_EQ(orderedHitables.size(), m_hitables.size());
+		m_hitables.swap(orderedHitables);
+	}
+	m_totalNodes = offset;
+
+	static const char* layoutNames[] = { "BVH2", "BVH4", "BVH8", "QBVH4", "QBVH8" };
+	Float elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::system_clock::now() - startTime).count();
+	K_INFO(stringPrintf("%s created with %d nodes for %d hitables (%.2f MB) in %.0f ms",
+		layoutNames[(int)m_layout], m_totalNodes, (int)m_hitables.size(),
+		float(treeBytes) / (1024.f * 1024.f), elapsed));
+}
+
+HitableBVH::~HitableBVH()
+{
+	FreeAligned(m_nodes);
+	FreeAligned(m_nodes4);
+	FreeAligned(m_nodes8);
+	FreeAligned(m_qnodes4);
+	FreeAligned(m_qnodes8);
+	FreeAligned(m_blocks4);
+	FreeAligned(m_blocks8);
+}
+
+Bounds3f HitableBVH::worldBound() const { return m_worldBound; }
+
+BVHBuildNode* HitableBVH::recursiveBuild(MemoryArena& arena, std::vector<BVHHitableInfo>& hitableInfo,
+	int start, int end, int& totalNodes, std::vector<Hitable::ptr>& orderedHitables)
+{
+	CHECK_NE(start, end);
+	BVHBuildNode* node = arena.Alloc<BVHBuildNode>();
+	++totalNodes;
+
+	// Compute bounds of all hitables in BVH node
+	Bounds3f bounds;
+	for (int i = start; i < end; ++i)
+		bounds = unionBounds(bounds, hitableInfo[i].bounds);
+
+	auto createLeaf = [&](int first, int last) -> BVHBuildNode*
+	{
+		int firstHitableOffset = orderedHitables.size();
+		for (int i = first; i < last; ++i)
+			orderedHitables.push_back(std::move(m_hitables[hitableInfo[i].hitableNumber]));
+		node->initLeaf(firstHitableOffset, last - first, bounds);
+		return node;
+	};
+
+	int nHitables = end - start;
+	if (nHitables == 1)
+		return createLeaf(start, end);
+
+	// Compute bound of hitable centroids, choose split dimension _dim_
+	Bounds3f centroidBounds;
+	for (int i = start; i < end; ++i)
+		centroidBounds = unionBounds(centroidBounds, hitableInfo[i].centroid);
+	int dim = centroidBounds.maximumExtent();
+
+	int mid = (start + end) / 2;
+	if (centroidBounds.m_pMax[dim] == centroidBounds.m_pMin[dim])
+	{
+		// All centroids coincide, there is no meaningful split plane. Keep them
+		// in a single leaf unless they overflow the leaf counter.
+		if (nHitables <= m_maxHitablesInNode)
+			return createLeaf(start, end);
+	}
+	else if (nHitables <= 2)
+	{
+		// Partition hitables into equally sized subsets
+		std::nth_element(&hitableInfo[start], &hitableInfo[mid], &hitableInfo[end - 1] + 1,
+			[dim](const BVHHitableInfo& a, const BVHHitableInfo& b)
+			{
+				return a.centroid[dim] < b.centroid[dim];
+			});
+	}
+	else
+	{
+		// Partition hitables using approximate SAH
+		constexpr int nBuckets = 12;
+		BVHBucketInfo buckets[nBuckets];
+
+		// Initialize _BVHBucketInfo_ for SAH partition buckets
+		auto bucketIndex = [&](const BVHHitableInfo& info) -> int
+		{
+			int b = nBuckets * centroidBounds.offset(info.centroid)[dim];
+			return glm::min(b, nBuckets - 1);
+		};
+		for (int i = start; i < end; ++i)
+		{
+			int b = bucketIndex(hitableInfo[i]);
+			buckets[b].count++;
+			buckets[b].bounds = unionBounds(buckets[b].bounds, hitableInfo[i].bounds);
+		}
+
+		// Compute costs for splitting after each bucket, sweeping from both ends
+		// so that every candidate is evaluated in O(1)
+		Float cost[nBuckets - 1];
+		Bounds3f b0;
+		int count0 = 0;
+		for (int i = 0; i < nBuckets - 1; ++i)
+		{
+			b0 = unionBounds(b0, buckets[i].bounds);
+			count0 += buckets[i].count;
+			cost[i] = count0 * (count0 > 0 ? b0.surfaceArea() : 0);
+		}
+		Bounds3f b1;
+		int count1 = 0;
+		for (int i = nBuckets - 1; i > 0; --i)
+		{
+			b1 = unionBounds(b1, buckets[i].bounds);
+			count1 += buckets[i].count;
+			cost[i - 1] += count1 * (count1 > 0 ? b1.surfaceArea() : 0);
+		}
+
+		// Find bucket to split at that minimizes SAH metric
+		//Note: the relative cost of a traversal step is 1/8 of a hitable test
+		Float invArea = 1 / bounds.surfaceArea();
+		int minCostSplitBucket = 0;
+		Float minCost = cost[0];
+		for (int i = 1; i < nBuckets - 1; ++i)
+		{
+			if (cost[i] < minCost)
+			{
+				minCost = cost[i];
+				minCostSplitBucket = i;
+			}
+		}
+		minCost = 0.125f + minCost * invArea;
+
+		// Either create leaf or split hitables at selected SAH bucket
+		Float leafCost = nHitables;
+		if (nHitables <= m_maxHitablesInNode && minCost >= leafCost)
+			return createLeaf(start, end);
+
+		BVHHitableInfo* hmid = std::partition(&hitableInfo[start], &hitableInfo[end - 1] + 1,
+			[=](const BVHHitableInfo& info)
+			{
+				return bucketIndex(info) <= minCostSplitBucket;
+			});
+		mid = hmid - &hitableInfo[0];
+
+		// Degenerated bucket partition, fall back to equal counts
+		if (mid == start || mid == end)
+		{
+			mid = (start + end) / 2;
+			std::nth_element(&hitableInfo[start], &hitableInfo[mid], &hitableInfo[end - 1] + 1,
+				[dim](const BVHHitableInfo& a, const BVHHitableInfo& b)
+				{
+					return a.centroid[dim] < b.centroid[dim];
+				});
+		}
+	}
+
+	node->initInterior(dim,
+		recursiveBuild(arena, hitableInfo, start, mid, totalNodes, orderedHitables),
+		recursiveBuild(arena, hitableInfo, mid, end, totalNodes, orderedHitables));
+	return node;
+}
+
+int HitableBVH::flattenBVHTree(BVHBuildNode* node, int& offset)
+{
+	LinearBVHNode* linearNode = &m_nodes[offset];
+	linearNode->bounds = node->bounds;
+	int myOffset = offset++;
+	if (node->nHitables > 0)
+	{
+		DCHECK(!node->children[0] && !node->children[1]);
+		CHECK_LT(node->nHitables, 65536);
+		linearNode->hitablesOffset = node->firstHitableOffset;
+		linearNode->nHitables = node->nHitables;
+		linearNode->triangleBlocks = 0;
+	}
+	else
+	{
+		// Create interior flattened BVH node
+		linearNode->axis = node->splitAxis;
+		linearNode->nHitables = 0;
+		linearNode->triangleBlocks = 0;
+		flattenBVHTree(node->children[0], offset);
+		linearNode->secondChildOffset = flattenBVHTree(node->children[1], offset);
+	}
+	return myOffset;
+}
+
+template <int N>
+int HitableBVH::packTriangleBlocks(TriangleBlock<N>*& blocks)
+{
+	//Note: only leaves whose hitables are all triangles are repacked, the others
+	//      keep the generic per-hitable loop.
+	auto isTriangleLeaf = [this](const LinearBVHNode& node) -> bool
+	{
+		if (node.nHitables == 0)
+			return false;
+		Vector3f p[3];
+		for (int i = 0; i < node.nHitables; ++i)
+		{
+			if (!m_hitables[node.hitablesOffset + i]->getTriangleVertices(p))
+				return false;
+		}
+		return true;
+	};
+
+	int nBlocks = 0;
+	for (int n = 0; n < m_totalNodes; ++n)
+	{
+		if (isTriangleLeaf(m_nodes[n]))
+			nBlocks += (m_nodes[n].nHitables + N - 1) / N;
+	}
+	if (nBlocks == 0)
+		return 0;
+
+	blocks = AllocAligned<TriangleBlock<N>>(nBlocks);
+	int blockOffset = 0;
+	for (int n = 0; n < m_totalNodes; ++n)
+	{
+		LinearBVHNode& node = m_nodes[n];
+		if (!isTriangleLeaf(node))
+			continue;
+
+		// Transpose the leaf triangles into SoA lanes, empty lanes are degenerate
+		const int firstBlock = blockOffset;
+		for (int first = 0; first < node.nHitables; first += N)
+		{
+			TriangleBlock<N>& block = blocks[blockOffset++];
+			for (int lane = 0; lane < N; ++lane)
+			{
+				Vector3f p[3] = { Vector3f(0.f), Vector3f(0.f), Vector3f(0.f) };
+				int index = -1;
+				if (first + lane < node.nHitables)
+				{
+					index = node.hitablesOffset + first + lane;
+					m_hitables[index]->getTriangleVertices(p);
+				}
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					block.p0[axis][lane] = p[0][axis];
+					block.p1[axis][lane] = p[1][axis];
+					block.p2[axis][lane] = p[2][axis];
+				}
+				block.hitableIndex[lane] = index;
+			}
+		}
+		node.hitablesOffset = firstBlock;
+		node.triangleBlocks = 1;
+	}
+	return nBlocks;
+}
+
+template <int N>
+bool HitableBVH::hitTriangleBlocks(const TriangleBlock<N>* blocks, const LinearBVHNode* node,
+	const Ray& ray, SurfaceInteraction* isect) const
+{
+	// Find the closest lane with the SIMD kernel, shrinking tMax as we go
+	Ray r = ray;
+	int closest = -1;
+	const int nBlocks = (node->nHitables + N - 1) / N;
+	const TriangleBlock<N>* leafBlocks = &blocks[node->hitablesOffset];
+	for (int b = 0; b < nBlocks; ++b)
+	{
+		Float tHit;
+		int lane = hitTriangleBlock(leafBlocks[b], r, tHit);
+		if (lane < 0)
+			continue;
+		if (isect == nullptr)
+			return true;
+		closest = leafBlocks[b].hitableIndex[lane];
+		r.m_tMax = tHit;
+	}
+	if (closest < 0)
+		return false;
+
+	//Note: differentials, material and area light are only computed for the closest hit.
+	if (m_hitables[closest]->hit(ray, *isect))
+		return true;
+
+	// The scalar recomputation disagreed near an edge, test the leaf one by one
+	bool hit = false;
+	for (int b = 0; b < nBlocks; ++b)
+	{
+		for (int lane = 0; lane < N; ++lane)
+		{
+			int index = leafBlocks[b].hitableIndex[lane];
+			if (index >= 0 && m_hitables[index]->hit(ray, *isect))
+				hit = true;
+		}
+	}
+	return hit;
+}
+
+bool HitableBVH::hitLeaf(const LinearBVHNode* node, const Ray& ray, SurfaceInteraction* isect) const
+{
+	if (node->triangleBlocks)
+	{
+		if (m_blocks8 != nullptr)
+			return hitTriangleBlocks(m_blocks8, node, ray, isect);
+		return hitTriangleBlocks(m_blocks4, node, ray, isect);
+	}
+
+	// Generic leaf, a null interaction asks for any hit
+	bool hit = false;
+	for (int i = 0; i < node->nHitables; ++i)
+	{
+		const Hitable::ptr& hitable = m_hitables[node->hitablesOffset + i];
+		if (isect == nullptr)
+		{
+			if (hitable->hit(ray))
+				return true;
+		}
+		else if (hitable->hit(ray, *isect))
+			hit = true;
+	}
+	return hit;
+}
+
+bool HitableBVH::hit(const Ray& ray, SurfaceInteraction& isect) const
+{
+	if (m_nodes4)
+		return hitWide(m_nodes4, ray, isect);
+	if (m_nodes8)
+		return hitWide(m_nodes8, ray, isect);
+	if (m_qnodes4)
+		return hitWide(m_qnodes4, ray, isect);
+	if (m_qnodes8)
+		return hitWide(m_qnodes8, ray, isect);
+	if (!m_nodes)
+		return false;
+
+	bool hit = false;
+	Vector3f invDir(1.f / ray.m_dir.x, 1.f / ray.m_dir.y, 1.f / ray.m_dir.z);
+	int dirIsNeg[3] = { invDir.x < 0, invDir.y < 0, invDir.z < 0 };
+
+	// Follow ray through BVH nodes to find hitable intersections
+	int toVisitOffset = 0, currentNodeIndex = 0;
+	int nodesToVisit[64];
+	while (true)
+	{
+		const LinearBVHNode* node = &m_nodes[currentNodeIndex];
+		//Note: ray.m_tMax shrinks on every closer hit, which culls farther nodes
+		if (node->bounds.hit(ray, invDir, dirIsNeg))
+		{
+			if (node->nHitables > 0)
+			{
+				// Intersect ray with hitables in leaf BVH node
+				if (hitLeaf(node, ray, &isect))
+					hit = true;
+				if (toVisitOffset == 0)
+					break;
+				currentNodeIndex = nodesToVisit[--toVisitOffset];
+			}
+			else
+			{
+				// Put far BVH node on _nodesToVisit_ stack, advance to near node
+				if (dirIsNeg[node->axis])
+				{
+					nodesToVisit[toVisitOffset++] = currentNodeIndex + 1;
+					currentNodeIndex = node->secondChildOffset;
+				}
+				else
+				{
+					nodesToVisit[toVisitOffset++] = node->secondChildOffset;
+					currentNodeIndex = currentNodeIndex + 1;
+				}
+			}
+		}
+		else
+		{
+			if (toVisitOffset == 0)
+				break;
+			currentNodeIndex = nodesToVisit[--toVisitOffset];
+		}
+	}
+	return hit;
+}
+
+bool HitableBVH::hit(const Ray& ray) const
+{
+	if (m_nodes4)
+		return hitWide(m_nodes4, ray);
+	if (m_nodes8)
+		return hitWide(m_nodes8, ray);
+	if (m_qnodes4)
+		return hitWide(m_qnodes4, ray);
+	if (m_qnodes8)
+		return hitWide(m_qnodes8, ray);
+	if (!m_nodes)
+		return false;
+
+	Vector3f invDir(1.f / ray.m_dir.x, 1.f / ray.m_dir.y, 1.f / ray.m_dir.z);
+	int dirIsNeg[3] = { invDir.x < 0, invDir.y < 0, invDir.z < 0 };
+
+	int toVisitOffset = 0, currentNodeIndex = 0;
+	int nodesToVisit[64];
+	while (true)
+	{
+		const LinearBVHNode* node = &m_nodes[currentNodeIndex];
+		if (node->bounds.hit(ray, invDir, dirIsNeg))
+		{
+			if (node->nHitables > 0)
+			{
+				// Any hit is enough for a shadow query
+				if (hitLeaf(node, ray, nullptr))
+					return true;
+				if (toVisitOffset == 0)
+					break;
+				currentNodeIndex = nodesToVisit[--toVisitOffset];
+			}
+			else
+			{
+				if (dirIsNeg[node->axis])
+				{
+					nodesToVisit[toVisitOffset++] = currentNodeIndex + 1;
+					currentNodeIndex = node->secondChildOffset;
+				}
+				else
+				{
+					nodesToVisit[toVisitOffset++] = node->secondChildOffset;
+					currentNodeIndex = currentNodeIndex + 1;
+				}
+			}
+		}
+		else
+		{
+			if (toVisitOffset == 0)
+				break;
+			currentNodeIndex = nodesToVisit[--toVisitOffset];
+		}
+	}
+	return false;
+}
+
+//Note: packet traversal for coherent rays. The packet is kept as SoA in groups of four
+//      lanes and every node is slab tested against all active groups with SSE. A node
+//      is visited once for the whole packet if any ray overlaps it, and the first group
+//      that hits it becomes the first active group of its subtree, the groups before
+//      it have missed an ancestor and are never tested again (interval culling).
+uint32_t HitableBVH::hit(const Ray* rays, int nRays, SurfaceInteraction* isects) const
+{
+	if (!m_nodes || nRays == 1)
+		return HitableAggregate::hit(rays, nRays, isects);
+	return hitPacket<false>(rays, nRays, isects);
+}
+
+//Note: any-hit version of the packet traversal above, a ray drops out of the packet at
+//      its first hit and the traversal ends as soon as every ray is blocked.
+uint32_t HitableBVH::occluded(const Ray* rays, int nRays) const
+{
+	if (!m_nodes || nRays == 1)
+		return HitableAggregate::occluded(rays, nRays);
+
+	// Rays heading into different octants share little of the traversal, test them one by one
+	auto octant = [](const Ray& ray) { return (ray.m_dir.x < 0) | (ray.m_dir.y < 0) << 1 | (ray.m_dir.z < 0) << 2; };
+	for (int i = 1; i < nRays; ++i)
+	{
+		if (octant(rays[i]) != octant(rays[0]))
+			return HitableAggregate::occluded(rays, nRays);
+	}
+	return hitPacket<true>(rays, nRays, nullptr);
+}
+
+template <bool AnyHit>
+uint32_t HitableBVH::hitPacket(const Ray* rays, int nRays, SurfaceInteraction* isects) const
+{
+	CHECK_LE(nRays, MaxRayPacketSize);
+	const uint32_t allRays = (1u << nRays) - 1;
+
+	const int nGroups = (nRays + 3) / 4;
+	alignas(16) float org[3][MaxRayPacketSize];
+	alignas(16) float invDir[3][MaxRayPacketSize];
+	alignas(16) float tMax[MaxRayPacketSize];
+	for (int i = 0; i < nGroups * 4; ++i)
+	{
+		//Note: padding lanes get an empty [0, -inf] interval and never hit
+		const Ray& ray = rays[glm::min(i, nRays - 1)];
+		for (int a = 0; a < 3; ++a)
+		{
+			org[a][i] = ray.m_origin[a];
+			invDir[a][i] = 1.f / ray.m_dir[a];
+		}
+		tMax[i] = i < nRays ? ray.m_tMax : -Infinity;
+	}
+
+	//Note: children are ordered by the direction of the first ray, rays with other
+	//      signs are still handled correctly but visit the far child first.
+	int dirIsNeg[3] = { invDir[0][0] < 0, invDir[1][0] < 0, invDir[2][0] < 0 };
+	const __m128 errScale = _mm_set1_ps(1 + 2 * gamma(3));
+
+	struct PacketStackEntry { int nodeIndex; int firstGroup; };
+	PacketStackEntry nodesToVisit[64];
+	int toVisitOffset = 0;
+	int currentNodeIndex = 0, firstGroup = 0;
+	uint32_t hitMask = 0;
+	while (true)
+	{
+		const LinearBVHNode* node = &m_nodes[currentNodeIndex];
+
+		// Slab test the active ray groups against the node bounds. Interior nodes stop
+		// at the first group that overlaps them, leaves need the exact mask of rays.
+		uint32_t activeMask = 0;
+		int firstHitGroup = -1;
+		for (int g = firstGroup; g < nGroups; ++g)
+		{
+			__m128 t0 = _mm_setzero_ps();
+			__m128 t1 = _mm_load_ps(tMax + 4 * g);
+			for (int a = 0; a < 3; ++a)
+			{
+				__m128 o = _mm_load_ps(org[a] + 4 * g);
+				__m128 inv = _mm_load_ps(invDir[a] + 4 * g);
+				__m128 tA = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node->bounds.m_pMin[a]), o), inv);
+				__m128 tB = _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(node->bounds.m_pMax[a]), o), inv);
+				t0 = _mm_max_ps(_mm_min_ps(tA, tB), t0);
+				t1 = _mm_min_ps(_mm_mul_ps(_mm_max_ps(tA, tB), errScale), t1);
+			}
+			uint32_t mask = _mm_movemask_ps(_mm_cmple_ps(t0, t1));
+			if (mask == 0)
+				continue;
+			if (firstHitGroup < 0)
+				firstHitGroup = g;
+			activeMask |= mask << (4 * g);
+			if (node->nHitables == 0)
+				break;
+		}
+
+		if (activeMask != 0)
+		{
+			if (node->nHitables > 0)
+			{
+				if (node->triangleBlocks)
+				{
+					// Triangle blocks are already batched, run the SIMD kernel per ray
+					for (int i = 0; i < nRays; ++i)
+					{
+						if ((activeMask & (1u << i)) && hitLeaf(node, rays[i], AnyHit ? nullptr : &isects[i]))
+						{
+							hitMask |= 1u << i;
+							tMax[i] = AnyHit ? -Infinity : rays[i].m_tMax;
+						}
+					}
+				}
+				else
+				{
+					// Intersect each hitable in the leaf with every active ray
+					for (int h = 0; h < node->nHitables; ++h)
+					{
+						const Hitable* hitable = m_hitables[node->hitablesOffset + h].get();
+						for (int i = 0; i < nRays; ++i)
+						{
+							if (!(activeMask & (1u << i)))
+								continue;
+							if (AnyHit ? hitable->hit(rays[i]) : hitable->hit(rays[i], isects[i]))
+							{
+								hitMask |= 1u << i;
+								tMax[i] = AnyHit ? -Infinity : rays[i].m_tMax;
+								// Blocked rays take no part in the rest of the traversal
+								if (AnyHit)
+									activeMask &= ~(1u << i);
+							}
+						}
+					}
+				}
+				if (toVisitOffset == 0 || (AnyHit && hitMask == allRays))
+					break;
+				--toVisitOffset;
+				currentNodeIndex = nodesToVisit[toVisitOffset].nodeIndex;
+				firstGroup = nodesToVisit[toVisitOffset].firstGroup;
+			}
+			else
+			{
+				// Put far BVH node on _nodesToVisit_ stack, advance to near node
+				firstGroup = firstHitGroup;
+				if (dirIsNeg[node->axis])
+				{
+					nodesToVisit[toVisitOffset++] = { currentNodeIndex + 1, firstGroup };
+					currentNodeIndex = node->secondChildOffset;
+				}
+				else
+				{
+					nodesToVisit[toVisitOffset++] = { node->secondChildOffset, firstGroup };
+					currentNodeIndex = currentNodeIndex + 1;
+				}
+			}
+		}
+		else
+		{
+			if (toVisitOffset == 0)
+				break;
+			--toVisitOffset;
+			currentNodeIndex = nodesToVisit[toVisitOffset].nodeIndex;
+			firstGroup = nodesToVisit[toVisitOffset].firstGroup;
+		}
+	}
+	return hitMask;
+}
+
+template <typename WideNode>
+void HitableBVH::collapseWideBVH(BVHBuildNode* node, WideNode* wideNodes, int nodeIndex, int& offset,
+	std::vector<Hitable::ptr>& orderedHitables)
+{
+	constexpr int N = WideNode::Width;
+	WideNode& wideNode = wideNodes[nodeIndex];
+
+	// Gather up to _N_ children, always opening the interior child with the largest surface area
+	BVHBuildNode* children[N];
+	int nChildren = 0;
+	if (node->nHitables > 0)
+	{
+		//Note: only the root can be a leaf here
+		children[nChildren++] = node;
+	}
+	else
+	{
+		children[nChildren++] = node->children[0];
+		children[nChildren++] = node->children[1];
+		while (nChildren < N)
+		{
+			int best = -1;
+			Float bestArea = -1;
+			for (int i = 0; i < nChildren; ++i)
+			{
+				if (children[i]->nHitables == 0 && children[i]->bounds.surfaceArea() > bestArea)
+				{
+					best = i;
+					bestArea = children[i]->bounds.surfaceArea();
+				}
+			}
+			if (best == -1)
+				break;
+			BVHBuildNode* opened = children[best];
+			children[best] = opened->children[0];
+			children[nChildren++] = opened->children[1];
+		}
+	}
+
+	setChildBounds(wideNode, children, nChildren);
+
+	// The interior children take consecutive nodes and the leaf children consecutive
+	// hitables, both in slot order
+	int32_t child[N];
+	uint16_t nHitables[N];
+	for (int i = 0; i < N; ++i)
+	{
+		child[i] = -1;
+		nHitables[i] = 0;
+	}
+	for (int i = 0; i < nChildren; ++i)
+	{
+		const BVHBuildNode* c = children[i];
+		if (c->nHitables > 0)
+		{
+			child[i] = (int32_t)orderedHitables.size();
+			nHitables[i] = uint16_t(c->nHitables);
+			for (int h = 0; h < c->nHitables; ++h)
+				orderedHitables.push_back(std::move(m_hitables[c->firstHitableOffset + h]));
+		}
+		else
+		{
+			child[i] = offset++;
+		}
+	}
+	setChildLinks(wideNode, child, nHitables);
+
+	for (int i = 0; i < nChildren; ++i)
+	{
+		if (nHitables[i] == 0)
+			collapseWideBVH(children[i], wideNodes, child[i], offset, orderedHitables);
+	}
+}
+
+template <typename WideNode>
+bool HitableBVH::hitWide(const WideNode* wideNodes, const Ray& ray, SurfaceInteraction& isect) const
+{
+	constexpr int N = WideNode::Width;
+	bool hit = false;
+	float org[3] = { ray.m_origin.x, ray.m_origin.y, ray.m_origin.z };
+	float invDir[3] = { 1.f / ray.m_dir.x, 1.f / ray.m_dir.y, 1.f / ray.m_dir.z };
+	int dirIsNeg[3] = { invDir[0] < 0, invDir[1] < 0, invDir[2] < 0 };
+
+	//Note: entries whose entry distance is beyond ray.m_tMax when popped are culled
+	struct StackEntry
+	{
+		int32_t child;
+		uint16_t nHitables;
+		float tEnter;
+	};
+	StackEntry stack[64 * N];
+	int stackSize = 0;
+	int currentNodeIndex = 0;
+	while (true)
+	{
+		const WideNode& node = wideNodes[currentNodeIndex];
+		float tEnter[N];
+		int mask = hitChildren(node, org, invDir, dirIsNeg, ray.m_tMax, tEnter);
+		int32_t child[N];
+		uint16_t nHitables[N];
+		getChildLinks(node, child, nHitables);
+
+		// Sort hit children by distance, nearest first
+		int order[N];
+		int nHits = 0;
+		for (int i = 0; i < N; ++i)
+		{
+			if (!(mask & (1 << i)))
+				continue;
+			int j = nHits++;
+			while (j > 0 && tEnter[order[j - 1]] > tEnter[i])
+			{
+				order[j] = order[j - 1];
+				--j;
+			}
+			order[j] = i;
+		}
+
+		// Push far to near so that the nearest child is visited first
+		for (int k = nHits - 1; k >= 0; --k)
+		{
+			int i = order[k];
+			stack[stackSize++] = { child[i], nHitables[i], tEnter[i] };
+		}
+
+		currentNodeIndex = -1;
+		while (stackSize > 0)
+		{
+			const StackEntry& entry = stack[--stackSize];
+			if (entry.tEnter > ray.m_tMax)
+				continue;
+			if (entry.nHitables > 0)
+			{
+				// Intersect ray with hitables in leaf
+				for (int i = 0; i < entry.nHitables; ++i)
+				{
+					if (m_hitables[entry.child + i]->hit(ray, isect))
+						hit = true;
+				}
+			}
+			else
+			{
+				currentNodeIndex = entry.child;
+				break;
+			}
+		}
+		if (currentNodeIndex < 0)
+			break;
+	}
+	return hit;
+}
+
+template <typename WideNode>
+bool HitableBVH::hitWide(const WideNode* wideNodes, const Ray& ray) const
+{
+	constexpr int N = WideNode::Width;
+	float org[3] = { ray.m_origin.x, ray.m_origin.y, ray.m_origin.z };
+	float invDir[3] = { 1.f / ray.m_dir.x, 1.f / ray.m_dir.y, 1.f / ray.m_dir.z };
+	int dirIsNeg[3] = { invDir[0] < 0, invDir[1] < 0, invDir[2] < 0 };
+
+	// Any hit is enough for a shadow query, children need no sorting
+	int nodesToVisit[64 * N];
+	int toVisitOffset = 0;
+	int currentNodeIndex = 0;
+	while (true)
+	{
+		const WideNode& node = wideNodes[currentNodeIndex];
+		float tEnter[N];
+		int mask = hitChildren(node, org, invDir, dirIsNeg, ray.m_tMax, tEnter);
+		int32_t child[N];
+		uint16_t nHitables[N];
+		getChildLinks(node, child, nHitables);
+		for (int i = 0; i < N; ++i)
+		{
+			if (!(mask & (1 << i)))
+				continue;
+			if (nHitables[i] > 0)
+			{
+				for (int j = 0; j < nHitables[i]; ++j)
+				{
+					if (m_hitables[child[i] + j]->hit(ray))
+						return true;
+				}
+			}
+			else
+			{
+				nodesToVisit[toVisitOffset++] = child[i];
+			}
+		}
+		if (toVisitOffset == 0)
+			break;
+		currentNodeIndex = nodesToVisit[--toVisitOffset];
+	}
+	return false;
+}
+
+RENDER_END
\ No newline at end of file
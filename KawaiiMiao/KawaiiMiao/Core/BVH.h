@@ -0,0 +1,127 @@
+#pragma once
+
+#include "Rendering.h"
+#include "Primitive.h"
+#include "TriangleMesh.h"
+#include "../Math/KMathUtil.h"
+
+#include <vector>
+
+RENDER_BEGIN
+
+struct BVHHitableInfo;
+struct BVHBuildNode;
+
+//Note: the nodes are stored in depth-first order, the first child of an interior
+//      node is located right after its parent and only the second child offset is
+//      recorded. sizeof(LinearBVHNode) -> 32 bytes, two nodes per cache line.
+struct LinearBVHNode
+{
+	Bounds3f bounds;
+	union
+	{
+		int hitablesOffset;		//leaf
+		int secondChildOffset;	//interior
+	};
+	uint16_t nHitables;			//0 -> interior node
+	uint8_t axis;				//interior node: xyz
+	uint8_t triangleBlocks;		//leaf: 1 -> hitablesOffset indexes SIMD triangle blocks
+};
+
+//Note: BVH4/BVH8 node collapsed from the binary build tree. Child bounds are
+//      stored as SoA so that a single SSE/AVX sequence tests all N children.
+template <int N>
+struct alignas(32) WideBVHNode
+{
+	static constexpr int Width = N;
+
+	float bMin[3][N];
+	float bMax[3][N];
+	int32_t child[N];				//interior: node offset, leaf: hitables offset, empty: -1
+	uint16_t nHitables[N];			//0 -> interior or empty slot
+};
+
+//Note: compressed BVH4/BVH8 node. Child bounds are 8-bit coordinates on a grid spanning
+//      the node's own bounds, the grid step of every axis is a power of two so that
+//      q * step is exact and the decoded bound origin + q * step only rounds once. The
+//      encoder checks every decoded bound and widens it until it contains the child,
+//      so no hit is missed. The interior children occupy consecutive nodes and the
+//      hitables of the leaf children consecutive entries, both in slot order, so two
+//      base offsets and the leaf sizes locate every child.
+//      sizeof -> 52 bytes for N = 4 and 80 bytes for N = 8.
+template <int N>
+struct QuantizedBVHNode
+{
+	static constexpr int Width = N;
+
+	float origin[3];
+	int8_t stepExponent[3];			//grid step of axis a -> 2^stepExponent[a]
+	uint8_t childMask;				//bit i set -> slot i is used
+	int32_t childBase;				//node offset of the first interior child
+	int32_t hitableBase;			//hitables offset of the first leaf child
+	uint8_t qMin[3][N];
+	uint8_t qMax[3][N];
+	uint8_t nHitables[N];			//0 -> interior or empty slot
+};
+
+enum class BVHLayout { Binary, BVH4, BVH8, QuantizedBVH4, QuantizedBVH8 };
+
+class HitableBVH final : public HitableAggregate
+{
+public:
+	typedef std::shared_ptr<HitableBVH> ptr;
+
+	HitableBVH(std::vector<Hitable::ptr> hitables, int maxHitablesInNode = 4,
+		BVHLayout layout = BVHLayout::Binary);
+	//Note: bulk path for indexed meshes, their triangles are appended after _hitables_.
+	HitableBVH(std::vector<Hitable::ptr> hitables, const std::vector<TriangleMesh::ptr>& meshes,
+		int maxHitablesInNode = 4, BVHLayout layout = BVHLayout::Binary);
+	~HitableBVH();
+
+	virtual bool hit(const Ray& ray) const override;
+	virtual bool hit(const Ray& ray, SurfaceInteraction& iset) const override;
+	virtual uint32_t hit(const Ray* rays, int nRays, SurfaceInteraction* isects) const override;
+	virtual uint32_t occluded(const Ray* rays, int nRays) const override;
+
+	virtual Bounds3f worldBound() const override;
+
+	int getNodeCount() const { return m_totalNodes; }
+
+private:
+	BVHBuildNode* recursiveBuild(MemoryArena& arena, std::vector<BVHHitableInfo>& hitableInfo,
+		int start, int end, int& totalNodes, std::vector<Hitable::ptr>& orderedHitables);
+
+	int flattenBVHTree(BVHBuildNode* node, int& offset);
+
+	template <int N>
+	int packTriangleBlocks(TriangleBlock<N>*& blocks);
+	template <int N>
+	bool hitTriangleBlocks(const TriangleBlock<N>* blocks, const LinearBVHNode* node,
+		const Ray& ray, SurfaceInteraction* isect) const;
+	bool hitLeaf(const LinearBVHNode* node, const Ray& ray, SurfaceInteraction* isect) const;
+	template <bool AnyHit>
+	uint32_t hitPacket(const Ray* rays, int nRays, SurfaceInteraction* isects) const;
+
+	template <typename WideNode>
+	void collapseWideBVH(BVHBuildNode* node, WideNode* wideNodes, int nodeIndex, int& offset,
+		std::vector<Hitable::ptr>& orderedHitables);
+	template <typename WideNode>
+	bool hitWide(const WideNode* wideNodes, const Ray& ray, SurfaceInteraction& isect) const;
+	template <typename WideNode>
+	bool hitWide(const WideNode* wideNodes, const Ray& ray) const;
+
+	const int m_maxHitablesInNode;
+	const BVHLayout m_layout;
+	std::vector<Hitable::ptr> m_hitables;
+	LinearBVHNode* m_nodes = nullptr;
+	WideBVHNode<4>* m_nodes4 = nullptr;
+	WideBVHNode<8>* m_nodes8 = nullptr;
+	QuantizedBVHNode<4>* m_qnodes4 = nullptr;
+	QuantizedBVHNode<8>* m_qnodes8 = nullptr;
+	TriangleBlock<4>* m_blocks4 = nullptr;
+	TriangleBlock<8>* m_blocks8 = nullptr;
+	Bounds3f m_worldBound;
+	int m_totalNodes = 0;
+};
+
+RENDER_END
\ No newline at end of file
@@ -22,6 +22,9 @@ Film::Film(const Vector2i& resolution, const Bounds2f& cropWindow, std::unique_p
 		" -> croppedPixelBounds ", m_croppedPixelBounds);
 
 	m_pixels = std::unique_ptr<APixel[]>(new APixel[m_croppedPixelBounds.area()]);
+	m_sampleCounts = std::unique_ptr<int[]>(new int[m_croppedPixelBounds.area()]());
+	m_nStripes = (m_croppedPixelBounds.diagonal().y + mergeStripeHeight - 1) / mergeStripeHeight;
+	m_stripeMutexes = std::unique_ptr<FilmMutexType[]>(new FilmMutexType[m_nStripes]);
 
 	//Precompute filter weight table
 	//Note: we assume that filtering function f(x,y)=f(|x|,|y|)
@@ -47,82 +50,139 @@ Bounds2i Film::getSampleBounds() const
 	return (Bounds2i)floatBounds;
 }
 
-std::unique_ptr<FilmTile> Film::getFilmTile(const Bounds2i& sampleBounds)
+Bounds2i Film::getFilmTilePixelBounds(const Bounds2i& sampleBounds) const
 {
 	// Bound image pixels that samples in _sampleBounds_ contribute to
 	Vector2f halfPixel = Vector2f(0.5f, 0.5f);
 	Bounds2f floatBounds = (Bounds2f)sampleBounds;
 	Vector2i p0 = (Vector2i)ceil(floatBounds.m_pMin - halfPixel - m_filter->m_radius);
 	Vector2i p1 = (Vector2i)floor(floatBounds.m_pMax - halfPixel + m_filter->m_radius) + Vector2i(1, 1);
-	Bounds2i tilePixelBounds = intersect(Bounds2i(p0, p1), m_croppedPixelBounds);
+	return intersect(Bounds2i(p0, p1), m_croppedPixelBounds);
+}
+
+std::unique_ptr<FilmTile> Film::getFilmTile(const Bounds2i& sampleBounds)
+{
+	Bounds2i tilePixelBounds = getFilmTilePixelBounds(sampleBounds);
 	return std::unique_ptr<FilmTile>(new FilmTile(tilePixelBounds, m_filter->m_radius,
 		m_filterTable, filterTableWidth, m_maxSampleLuminance));
 }
 
+bool Film::resetFilmTile(FilmTile& tile, const Bounds2i& sampleBounds) const
+{
+	DCHECK(tile.m_filterTable == m_filterTable);
+	return tile.reset(getFilmTilePixelBounds(sampleBounds));
+}
+
 void Film::mergeFilmTile(std::unique_ptr<FilmTile> tile)
 {
-	std::lock_guard<std::mutex> lock(m_mutex);
-	for (Vector2i pixel : tile->getPixelBounds())
+	mergeFilmTile(*tile);
+}
+
+void Film::mergeFilmTile(const FilmTile& tile)
+{
+	mergeFilmTile(tile, nullptr);
+}
+
+void Film::mergeFilmTile(const FilmTile& tile, FilmMergeTicket& ticket)
+{
+	mergeFilmTile(tile, &ticket);
+}
+
+void Film::mergeFilmTile(const FilmTile& tile, FilmMergeTicket* ticket)
+{
+	Bounds2i tileBounds = tile.getPixelBounds();
+	FilmMutexType::scoped_lock locks[2];
+	int stripe = -1;
+	int y = tileBounds.m_pMin.y;
+	while (y < tileBounds.m_pMax.y)
 	{
-		// Merge _pixel_ into _Film::pixels_
-		const FilmTilePixel& tilePixel = tile->getPixel(pixel);
-		APixel& mergePixel = getPixel(pixel);
-		Float xyz[3];
-		tilePixel.contribSum.toXYZ(xyz);
-		for (int i = 0; i < 3; ++i)
+		// Merge the rows of the tile that fall into the current stripe
+		int prevStripe = stripe;
+		stripe = (y - m_croppedPixelBounds.m_pMin.y) / mergeStripeHeight;
+		int stripeEnd = glm::min(tileBounds.m_pMax.y,
+			m_croppedPixelBounds.m_pMin.y + (stripe + 1) * mergeStripeHeight);
+		locks[stripe & 1].acquire(m_stripeMutexes[stripe]);
+		if (prevStripe >= 0)
+			locks[prevStripe & 1].release();
+		for (; y < stripeEnd; ++y)
 		{
-			mergePixel.m_xyz[i] += xyz[i];
+			for (int x = tileBounds.m_pMin.x; x < tileBounds.m_pMax.x; ++x)
+			{
+				// Merge _pixel_ into _Film::pixels_
+				Vector2i pixel(x, y);
+				const FilmTilePixel& tilePixel = tile.getPixel(pixel);
+				APixel& mergePixel = getPixel(pixel);
+				Float xyz[3];
+				tilePixel.contribSum.toXYZ(xyz);
+				for (int i = 0; i < 3; ++i)
+				{
+					mergePixel.m_xyz[i] += xyz[i];
+				}
+				mergePixel.m_filterWeightSum += tilePixel.filterWeightSum;
+				m_sampleCounts[getPixelOffset(pixel)] += tilePixel.nSamples;
+			}
 		}
-		mergePixel.m_filterWeightSum += tilePixel.filterWeightSum;
+	}
+
+	// Still holding the lock of the last stripe
+	if (ticket != nullptr && stripe >= 0)
+	{
+		ticket->stripe = stripe;
+		ticket->number = m_mergeCount++;
 	}
 }
 
 void Film::writeImageToFile(Float splatScale)
+{
+	writeImageToFile(m_filename, splatScale);
+}
+
+void Film::writeImageToFile(const std::string& filename, Float splatScale)
 {
 	std::cout << "Converting image to RGB and computing final weighted pixel values";
 	std::unique_ptr<Float[]> rgb(new Float[3 * m_croppedPixelBounds.area()]);
 	std::unique_ptr<Byte[]>  dst(new Byte[3 * m_croppedPixelBounds.area()]);
-	int offset = 0;
-	for (Vector2i p : m_croppedPixelBounds)
-	{
-		// Convert pixel XYZ color to RGB
-		APixel& pixel = getPixel(p);
-		XYZToRGB(pixel.m_xyz, &rgb[3 * offset]);
-
-		// Normalize pixel with weight sum
-		Float filterWeightSum = pixel.m_filterWeightSum;
-		if (filterWeightSum != 0)
+	forEachStripe([&](int begin, int end)
 		{
-			Float invWt = (Float)1 / filterWeightSum;
-			rgb[3 * offset + 0] = glm::max((Float)0, rgb[3 * offset + 0] * invWt);
-			rgb[3 * offset + 1] = glm::max((Float)0, rgb[3 * offset + 1] * invWt);
-			rgb[3 * offset + 2] = glm::max((Float)0, rgb[3 * offset + 2] * invWt);
-		}
+			for (int offset = begin; offset < end; ++offset)
+			{
+				// Convert pixel XYZ color to RGB
+				APixel& pixel = m_pixels[offset];
+				XYZToRGB(pixel.m_xyz, &rgb[3 * offset]);
 
-		// Add splat value at pixel
-		Float splatRGB[3];
-		Float splatXYZ[3] = { pixel.m_splatXYZ[0], pixel.m_splatXYZ[1],  pixel.m_splatXYZ[2] };
-		XYZToRGB(splatXYZ, splatRGB);
-		rgb[3 * offset + 0] += splatScale * splatRGB[0];
-		rgb[3 * offset + 1] += splatScale * splatRGB[1];
-		rgb[3 * offset + 2] += splatScale * splatRGB[2];
-
-		// Scale pixel value by _scale_
-		rgb[3 * offset + 0] *= m_scale;
-		rgb[3 * offset + 1] *= m_scale;
-		rgb[3 * offset + 2] *= m_scale;
-
-#define TO_BYTE(v) (uint8_t) clamp(255.f * gammaCorrect(v) + 0.5f, 0.f, 255.f)
-		dst[3 * offset + 0] = TO_BYTE(rgb[3 * offset + 0]);
-		dst[3 * offset + 1] = TO_BYTE(rgb[3 * offset + 1]);
-		dst[3 * offset + 2] = TO_BYTE(rgb[3 * offset + 2]);
-
-		++offset;
-	}
+				// Normalize pixel with weight sum
+				Float filterWeightSum = pixel.m_filterWeightSum;
+				if (filterWeightSum != 0)
+				{
+					Float invWt = (Float)1 / filterWeightSum;
+					rgb[3 * offset + 0] = glm::max((Float)0, rgb[3 * offset + 0] * invWt);
+					rgb[3 * offset + 1] = glm::max((Float)0, rgb[3 * offset + 1] * invWt);
+					rgb[3 * offset + 2] = glm::max((Float)0, rgb[3 * offset + 2] * invWt);
+				}
+
+				// Add splat value at pixel
+				Float splatRGB[3];
+				Float splatXYZ[3] = { pixel.m_splatXYZ[0], pixel.m_splatXYZ[1], pixel.m_splatXYZ[2] };
+				XYZToRGB(splatXYZ, splatRGB);
+				rgb[3 * offset + 0] += splatScale * splatRGB[0];
+				rgb[3 * offset + 1] += splatScale * splatRGB[1];
+				rgb[3 * offset + 2] += splatScale * splatRGB[2];
+
+				// Scale pixel value by _scale_
+				rgb[3 * offset + 0] *= m_scale;
+				rgb[3 * offset + 1] *= m_scale;
+				rgb[3 * offset + 2] *= m_scale;
+
+		#define TO_BYTE(v) (uint8_t) clamp(255.f * gammaCorrect(v) + 0.5f, 0.f, 255.f)
+				dst[3 * offset + 0] = TO_BYTE(rgb[3 * offset + 0]);
+				dst[3 * offset + 1] = TO_BYTE(rgb[3 * offset + 1]);
+				dst[3 * offset + 2] = TO_BYTE(rgb[3 * offset + 2]);
+			}
+		});
 
-	std::cout << "Writing image " << m_filename << " with bounds " << m_croppedPixelBounds;
+	std::cout << "Writing image " << filename << " with bounds " << m_croppedPixelBounds;
 	auto extent = m_croppedPixelBounds.diagonal();
-	stbi_write_png(m_filename.c_str(),
+	stbi_write_png(filename.c_str(),
 		extent.x,
 		extent.y,
 		3,
@@ -130,6 +190,42 @@ void Film::writeImageToFile(Float splatScale)
 		extent.x * 3);
 }
 
+void Film::writeSampleCountToFile(const std::string& filename) const
+{
+	int nPixels = m_croppedPixelBounds.area();
+	int maxCount = 1;
+	for (int i = 0; i < nPixels; ++i)
+	{
+		maxCount = glm::max(maxCount, m_sampleCounts[i]);
+	}
+
+	std::unique_ptr<Byte[]> dst(new Byte[nPixels]);
+	for (int i = 0; i < nPixels; ++i)
+	{
+		dst[i] = (Byte)(255.f * m_sampleCounts[i] / maxCount + 0.5f);
+	}
+
+	K_INFO(stringPrintf("Writing sample count map %s (max %d samples per pixel)", filename.c_str(), maxCount));
+	auto extent = m_croppedPixelBounds.diagonal();
+	stbi_write_png(filename.c_str(),
+		extent.x,
+		extent.y,
+		1,
+		static_cast<void*>(dst.get()),
+		extent.x);
+}
+
+Float Film::getAverageSampleCount() const
+{
+	int nPixels = m_croppedPixelBounds.area();
+	int64_t nSamples = 0;
+	for (int i = 0; i < nPixels; ++i)
+	{
+		nSamples += m_sampleCounts[i];
+	}
+	return nPixels > 0 ? (Float)nSamples / nPixels : 0.f;
+}
+
 void Film::setImage(const Spectrum* img) const
 {
 	int nPixels = m_croppedPixelBounds.area();
@@ -175,14 +271,33 @@ void Film::addSplat(const Vector2f& p, Spectrum v)
 		v *= m_maxSampleLuminance / v.y();
 	}
 
-	Float xyz[3];
-	v.toXYZ(xyz);
+	SplatBuffer& buffer = m_splatBuffers.local();
+	if (buffer.capacity() == 0)
+		buffer.reserve(splatBufferSize);
+
+	Splat splat;
+	splat.offset = getPixelOffset(pi);
+	v.toXYZ(splat.xyz);
+	buffer.push_back(splat);
+	if ((int)buffer.size() == splatBufferSize)
+		flushSplats(buffer);
+}
 
-	APixel& pixel = getPixel(pi);
-	for (int i = 0; i < 3; ++i)
+void Film::flushSplats(SplatBuffer& buffer)
+{
+	for (const Splat& splat : buffer)
 	{
-		pixel.m_splatXYZ[i].add(xyz[i]);
+		APixel& pixel = m_pixels[splat.offset];
+		for (int c = 0; c < 3; ++c)
+			pixel.m_splatXYZ[c].add(splat.xyz[c]);
 	}
+	buffer.clear();
+}
+
+void Film::mergeSplats()
+{
+	for (SplatBuffer& buffer : m_splatBuffers)
+		flushSplats(buffer);
 }
 
 void Film::clear()
@@ -196,6 +311,60 @@ void Film::clear()
 		}
 		pixel.m_filterWeightSum = 0;
 	}
+	std::fill(m_sampleCounts.get(), m_sampleCounts.get() + m_croppedPixelBounds.area(), 0);
+	m_splatBuffers.clear();
+}
+
+std::vector<FilmPixelState> Film::getPixelStates(std::vector<int64_t>* stripeMergeCounts)
+{
+	std::vector<FilmPixelState> states(m_croppedPixelBounds.area());
+	if (stripeMergeCounts != nullptr)
+		stripeMergeCounts->resize(m_nStripes);
+	int stripe = 0;
+	forEachStripe([&](int begin, int end)
+		{
+			if (stripeMergeCounts != nullptr)
+				(*stripeMergeCounts)[stripe] = m_mergeCount;
+			++stripe;
+			for (int i = begin; i < end; ++i)
+			{
+				const APixel& pixel = m_pixels[i];
+				FilmPixelState& state = states[i];
+				for (int c = 0; c < 3; ++c)
+				{
+					state.xyz[c] = pixel.m_xyz[c];
+					state.splatXYZ[c] = pixel.m_splatXYZ[c];
+				}
+				state.filterWeightSum = pixel.m_filterWeightSum;
+				state.sampleCount = m_sampleCounts[i];
+			}
+		});
+	return states;
+}
+
+bool Film::setPixelStates(const std::vector<FilmPixelState>& states)
+{
+	int nPixels = m_croppedPixelBounds.area();
+	if ((int)states.size() != nPixels)
+		return false;
+
+	m_splatBuffers.clear();
+	forEachStripe([&](int begin, int end)
+		{
+			for (int i = begin; i < end; ++i)
+			{
+				APixel& pixel = m_pixels[i];
+				const FilmPixelState& state = states[i];
+				for (int c = 0; c < 3; ++c)
+				{
+					pixel.m_xyz[c] = state.xyz[c];
+					pixel.m_splatXYZ[c] = state.splatXYZ[c];
+				}
+				pixel.m_filterWeightSum = state.filterWeightSum;
+				m_sampleCounts[i] = state.sampleCount;
+			}
+		});
+	return true;
 }
 
 RENDER_END
\ No newline at end of file
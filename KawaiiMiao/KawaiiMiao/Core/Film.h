@@ -6,8 +6,10 @@
 #include "../Tool/Parallel.h"
 #include "../Math/KMathUtil.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
+#include <tbb/tbb/enumerable_thread_specific.h>
 
 RENDER_BEGIN
 
@@ -15,6 +17,29 @@ struct FilmTilePixel
 {
 	Spectrum contribSum = 0.f;
 	Float filterWeightSum = 0.f;
+
+	//Note: running luminance mean and variance (Welford) of the samples taken
+	//      inside this pixel, adaptive sampling derives the pixel error from them.
+	int nSamples = 0;
+	Float lumMean = 0.f;
+	Float lumM2 = 0.f;
+};
+
+//Note: raw accumulation state of a film pixel, saved and restored by checkpoints.
+struct FilmPixelState
+{
+	Float xyz[3];
+	Float filterWeightSum;
+	Float splatXYZ[3];
+	int32_t sampleCount;
+};
+
+//Note: position of a tile merge in the merge order of the last row stripe the tile covers,
+//      written under that stripe's lock. See Film::getPixelStates().
+struct FilmMergeTicket
+{
+	std::atomic<int32_t> stripe{ -1 };
+	std::atomic<int64_t> number{ -1 };
 };
 
 class Film final
@@ -28,17 +53,40 @@ public:
 
 	Bounds2i getSampleBounds() const;
 	const Vector2i getResolution() const { return m_resolution; }
+	const std::string& getFilename() const { return m_filename; }
+	Bounds2i getCroppedPixelBounds() const { return m_croppedPixelBounds; }
 
 	std::unique_ptr<FilmTile> getFilmTile(const Bounds2i& sampleBounds);
+	//Note: turns a tile of this film into the tile of _sampleBounds_ and keeps its pixel
+	//      storage, returns true if the storage had to grow.
+	bool resetFilmTile(FilmTile& tile, const Bounds2i& sampleBounds) const;
 	void mergeFilmTile(std::unique_ptr<FilmTile> tile);
+	void mergeFilmTile(const FilmTile& tile);
+	void mergeFilmTile(const FilmTile& tile, FilmMergeTicket& ticket);
+	// Number the next ticketed merge gets, merges with a lower number took their tickets before
+	int64_t getMergeCount() const { return m_mergeCount; }
 
 	void writeImageToFile(Float splatScale = 1);
+	//Note: safe to call while tiles are being merged, e.g. for progressive snapshots
+	void writeImageToFile(const std::string& filename, Float splatScale = 1);
+	//Note: grayscale image of the number of samples taken per pixel, scaled to the maximum
+	void writeSampleCountToFile(const std::string& filename) const;
+	Float getAverageSampleCount() const;
 
 	void setImage(const Spectrum* img) const;
 	void addSplat(const Vector2f& p, Spectrum v);
+	//Note: folds the pending splats of every thread into the pixels, call it once the
+	//      splatting threads are done. Until then images miss at most a buffer per thread.
+	void mergeSplats();
 
 	void clear();
 
+	//Note: both are serialized against mergeFilmTile() stripe by stripe, the states are in
+	//      scanline order of the cropped pixel bounds. A ticketed merge is contained in the
+	//      states iff its number is below the _stripeMergeCounts_ entry of its stripe.
+	std::vector<FilmPixelState> getPixelStates(std::vector<int64_t>* stripeMergeCounts = nullptr);
+	bool setPixelStates(const std::vector<FilmPixelState>& states);
+
 private:
 
 	//Note: XYZ is a display independent representation of color,
@@ -59,12 +107,32 @@ private:
 	const Vector2i m_resolution; //(width, height)
 	const std::string m_filename;
 	std::unique_ptr<APixel[]> m_pixels;
+	std::unique_ptr<int[]> m_sampleCounts;
 
 	const Float m_diagonal;
 	Bounds2i m_croppedPixelBounds;	//actual rendering window
 
 	std::unique_ptr<Filter> m_filter;
-	std::mutex m_mutex;
+
+	//Note: tiles are merged under the locks of the row stripes they cover, so only tiles
+	//      whose filter borders share rows ever wait on each other. The locks are taken hand
+	//      over hand in stripe order, hence no merge or pass over the film overtakes another.
+	static constexpr int mergeStripeHeight = 4;
+	int m_nStripes;
+	std::unique_ptr<FilmMutexType[]> m_stripeMutexes;
+	std::atomic<int64_t> m_mergeCount{ 0 };
+
+	//Note: every splatting thread queues its splats in a small buffer and adds them to
+	//      APixel::m_splatXYZ once it is full, so the memory does not grow with the film
+	//      and readers only ever look at the pixels.
+	struct Splat
+	{
+		int offset;
+		Float xyz[3];
+	};
+	static constexpr int splatBufferSize = 4096;
+	using SplatBuffer = std::vector<Splat>;
+	tbb::enumerable_thread_specific<SplatBuffer> m_splatBuffers;
 
 	//Note: precomputed filter weights table
 	static constexpr int filterTableWidth = 16;
@@ -73,6 +141,29 @@ private:
 	const Float m_scale;
 	const Float m_maxSampleLuminance;
 
+	Bounds2i getFilmTilePixelBounds(const Bounds2i& sampleBounds) const;
+
+	void flushSplats(SplatBuffer& buffer);
+
+	// Runs _func(begin, end)_ on the pixel offsets of every row stripe while holding its lock
+	template <typename Func>
+	void forEachStripe(Func func)
+	{
+		Vector2i extent = m_croppedPixelBounds.diagonal();
+		FilmMutexType::scoped_lock locks[2];
+		for (int stripe = 0; stripe < m_nStripes; ++stripe)
+		{
+			int y0 = stripe * mergeStripeHeight;
+			int y1 = glm::min(y0 + mergeStripeHeight, extent.y);
+			locks[stripe & 1].acquire(m_stripeMutexes[stripe]);
+			if (stripe > 0)
+				locks[(stripe - 1) & 1].release();
+			func(y0 * extent.x, y1 * extent.x);
+		}
+	}
+
+	void mergeFilmTile(const FilmTile& tile, FilmMergeTicket* ticket);
+
 	APixel& getPixel(const Vector2i& p)
 	{
 		DCHECK(insideExclusive(p, m_croppedPixelBounds));
@@ -81,6 +172,13 @@ private:
 		return m_pixels[index];
 	}
 
+	int getPixelOffset(const Vector2i& p) const
+	{
+		DCHECK(insideExclusive(p, m_croppedPixelBounds));
+		int width = m_croppedPixelBounds.m_pMax.x - m_croppedPixelBounds.m_pMin.x;
+		return (p.x - m_croppedPixelBounds.m_pMin.x) + (p.y - m_croppedPixelBounds.m_pMin.y) * width;
+	}
+
 };
 
 class FilmTile final
@@ -97,6 +195,24 @@ public:
 		m_pixels = std::vector<FilmTilePixel>(glm::max(0, pixelBounds.area()));
 	}
 
+	//Note: reserves the storage of the largest tile of _tileSize_ x _tileSize_ samples,
+	//      the filter footprint reaches up to one radius past each side.
+	void reserve(int tileSize)
+	{
+		int width = tileSize + 2 * (int)std::ceil(m_filterRadius.x) + 1;
+		int height = tileSize + 2 * (int)std::ceil(m_filterRadius.y) + 1;
+		m_pixels.reserve(width * height);
+	}
+
+	bool reset(const Bounds2i& pixelBounds)
+	{
+		size_t nPixels = glm::max(0, pixelBounds.area());
+		bool grow = nPixels > m_pixels.capacity();
+		m_pixelBounds = pixelBounds;
+		m_pixels.assign(nPixels, FilmTilePixel());
+		return grow;
+	}
+
 	void addSample(const Vector2f& pFilm, Spectrum L, Float sampleWeight = 1.f)
 	{
 		if (L.y() > m_maxSampleLuminance)
@@ -158,10 +274,40 @@ public:
 		return m_pixels[index];
 	}
 
+	//Note: records the luminance of a sample taken inside _p_, kept apart from addSample()
+	//      since the filter spreads a sample over its neighbours as well.
+	void addPixelStatistics(const Vector2i& p, const Spectrum& L, Float sampleWeight = 1.f)
+	{
+		if (!insideExclusive(p, m_pixelBounds))
+			return;
+
+		FilmTilePixel& pixel = getPixel(p);
+		Float lum = glm::min(L.y(), m_maxSampleLuminance) * sampleWeight;
+		Float delta = lum - pixel.lumMean;
+		++pixel.nSamples;
+		pixel.lumMean += delta / pixel.nSamples;
+		pixel.lumM2 += delta * (lum - pixel.lumMean);
+	}
+
+	//Note: standard error of the pixel's mean luminance relative to the mean itself,
+	//      pixels outside the tile report zero since nothing can be measured there.
+	Float getRelativeError(const Vector2i& p) const
+	{
+		if (!insideExclusive(p, m_pixelBounds))
+			return 0.f;
+
+		const FilmTilePixel& pixel = getPixel(p);
+		if (pixel.nSamples < 2)
+			return Infinity;
+
+		Float variance = pixel.lumM2 / (pixel.nSamples - 1);
+		return std::sqrt(variance / pixel.nSamples) / glm::max(pixel.lumMean, (Float)1e-3);
+	}
+
 	Bounds2i getPixelBounds() const { return m_pixelBounds; }
 
 private:
-	const Bounds2i m_pixelBounds;
+	Bounds2i m_pixelBounds;
 	const Vector2f m_filterRadius, m_invFilterRadius;
 	const Float* m_filterTable;
 	const int m_filterTableSize;
@@ -0,0 +1,85 @@
+#include "FilmCheckpoint.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+RENDER_BEGIN
+
+//Note: file layout -> header, one done flag per tile, then the pixel states.
+struct FilmCheckpointHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint32_t floatSize;			//sizeof(Float), float and double builds do not mix
+	int32_t width;
+	int32_t height;
+	int32_t nTiles;
+	int64_t samplesPerPixel;
+	int32_t pass;
+	int32_t reserved;
+};
+
+static const char filmCheckpointMagic[4] = { 'K', 'M', 'C', 'P' };
+static const uint32_t filmCheckpointVersion = 1;
+
+bool FilmCheckpoint::write(const std::string& filename) const
+{
+	CHECK_EQ((int)tilesDone.size(), nTiles);
+	CHECK_EQ((int)pixels.size(), extent.x * extent.y);
+
+	FilmCheckpointHeader header;
+	std::memcpy(header.magic, filmCheckpointMagic, 4);
+	header.version = filmCheckpointVersion;
+	header.floatSize = sizeof(Float);
+	header.width = extent.x;
+	header.height = extent.y;
+	header.nTiles = nTiles;
+	header.samplesPerPixel = samplesPerPixel;
+	header.pass = pass;
+	header.reserved = 0;
+
+	const std::string tmpPath = filename + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+
+		out.write(reinterpret_cast<const char*>(&header), sizeof(FilmCheckpointHeader));
+		out.write(reinterpret_cast<const char*>(tilesDone.data()), tilesDone.size());
+		out.write(reinterpret_cast<const char*>(pixels.data()), pixels.size() * sizeof(FilmPixelState));
+		if (!out)
+			return false;
+	}
+
+	std::remove(filename.c_str());
+	return std::rename(tmpPath.c_str(), filename.c_str()) == 0;
+}
+
+bool FilmCheckpoint::read(const std::string& filename)
+{
+	std::ifstream in(filename, std::ios::binary);
+	if (!in)
+		return false;
+
+	FilmCheckpointHeader header;
+	in.read(reinterpret_cast<char*>(&header), sizeof(FilmCheckpointHeader));
+	if (!in || std::memcmp(header.magic, filmCheckpointMagic, 4) != 0 ||
+		header.version != filmCheckpointVersion || header.floatSize != sizeof(Float) ||
+		header.width <= 0 || header.height <= 0 || header.nTiles <= 0)
+	{
+		return false;
+	}
+
+	extent = Vector2i(header.width, header.height);
+	samplesPerPixel = header.samplesPerPixel;
+	nTiles = header.nTiles;
+	pass = header.pass;
+	tilesDone.resize(nTiles);
+	pixels.resize((size_t)extent.x * extent.y);
+	in.read(reinterpret_cast<char*>(tilesDone.data()), tilesDone.size());
+	in.read(reinterpret_cast<char*>(pixels.data()), pixels.size() * sizeof(FilmPixelState));
+	return (bool)in;
+}
+
+RENDER_END
\ No newline at end of file
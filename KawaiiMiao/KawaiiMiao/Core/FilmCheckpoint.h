@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Rendering.h"
+#include "Film.h"
+#include "../Math/KMathUtil.h"
+
+#include <string>
+#include <vector>
+
+RENDER_BEGIN
+
+//Note: everything progressive rendering needs to continue an interrupted render. Passes
+//      before _pass_ are complete, of _pass_ itself only the tiles flagged in _tilesDone_
+//      have been merged. Tile samplers are seeded from the tile and the pass, hence the
+//      remaining tiles draw exactly the samples they would have drawn without interruption.
+struct FilmCheckpoint
+{
+	Vector2i extent;				//cropped film resolution
+	int64_t samplesPerPixel = 0;
+	int32_t nTiles = 0;
+	int32_t pass = 0;
+	std::vector<uint8_t> tilesDone;
+	std::vector<FilmPixelState> pixels;
+
+	// Written to a temporary file first and renamed, a crash while writing keeps the
+	// previous checkpoint intact.
+	bool write(const std::string& filename) const;
+	bool read(const std::string& filename);
+};
+
+RENDER_END
\ No newline at end of file
@@ -7,9 +7,143 @@
 #include "../Tool/Reporter.h"
 #include "BSDF.h"
 #include "LightDistrib.h"
+#include "FilmCheckpoint.h"
+
+#include <algorithm>
+#include <future>
 
 RENDER_BEGIN
 
+void SamplerIntegrator::setRayPacketSize(int packetSize)
+{
+	CHECK_GE(packetSize, 1);
+	CHECK_LE(packetSize, MaxRayPacketSize);
+	m_rayPacketSize = packetSize;
+}
+
+void SamplerIntegrator::setTiling(TileOrder order, int tileSize)
+{
+	CHECK_GE(tileSize, 1);
+	m_tileOrder = order;
+	m_tileSize = tileSize;
+}
+
+// Interleaves the bits of _x_ and _y_, x takes the even bits
+static uint64_t mortonCode2(uint32_t x, uint32_t y)
+{
+	uint64_t code = 0;
+	for (int i = 0; i < 32; ++i)
+	{
+		code |= (uint64_t)((x >> i) & 1) << (2 * i);
+		code |= (uint64_t)((y >> i) & 1) << (2 * i + 1);
+	}
+	return code;
+}
+
+// Distance of (x, y) along the Hilbert curve filling the _n_ x _n_ grid, _n_ a power of two
+static uint64_t hilbertIndex(uint32_t n, uint32_t x, uint32_t y)
+{
+	uint64_t d = 0;
+	for (uint32_t s = n / 2; s > 0; s /= 2)
+	{
+		uint32_t rx = (x & s) > 0;
+		uint32_t ry = (y & s) > 0;
+		d += (uint64_t)s * s * ((3 * rx) ^ ry);
+		// Rotate the quadrant so that the curve enters it at its origin
+		if (ry == 0)
+		{
+			if (rx == 1)
+			{
+				x = s - 1 - x;
+				y = s - 1 - y;
+			}
+			std::swap(x, y);
+		}
+	}
+	return d;
+}
+
+std::vector<int> SamplerIntegrator::computeTileOrder(const Vector2i& nTiles, TileOrder order)
+{
+	std::vector<int> tiles(nTiles.x * nTiles.y);
+	for (int t = 0; t < (int)tiles.size(); ++t)
+		tiles[t] = t;
+	if (order == TileOrder::RowMajor)
+		return tiles;
+
+	//Note: the curves are laid over the enclosing power of two grid, tiles outside of the
+	//      image are skipped by sorting the image tiles along it.
+	uint32_t n = 1;
+	while (n < (uint32_t)glm::max(nTiles.x, nTiles.y))
+		n *= 2;
+	Vector2f center(0.5f * (nTiles.x - 1), 0.5f * (nTiles.y - 1));
+
+	std::vector<std::pair<uint64_t, int>> keys(tiles.size());
+	for (int t = 0; t < (int)tiles.size(); ++t)
+	{
+		uint32_t x = t % nTiles.x, y = t / nTiles.x;
+		uint64_t key = 0;
+		if (order == TileOrder::Morton)
+			key = mortonCode2(x, y);
+		else if (order == TileOrder::Hilbert)
+			key = hilbertIndex(n, x, y);
+		else
+		{
+			// Rings of tiles around the center, counterclockwise within a ring
+			Float dx = x - center.x, dy = y - center.y;
+			uint64_t ring = (uint64_t)glm::ceil(glm::max(glm::abs(dx), glm::abs(dy)));
+			Float angle = std::atan2(dy, dx) + Pi;
+			key = (ring << 32) | (uint64_t)(angle * Inv2Pi * 0xffff);
+		}
+		keys[t] = std::make_pair(key, t);
+	}
+	std::sort(keys.begin(), keys.end());
+	for (int t = 0; t < (int)tiles.size(); ++t)
+		tiles[t] = keys[t].second;
+	return tiles;
+}
+
+void SamplerIntegrator::setAdaptiveSampling(int minSamples, Float maxError, const std::string& sampleMapFilename)
+{
+	CHECK_GE(maxError, 0);
+	//Note: the variance estimate needs at least two samples
+	m_minSamples = glm::max(minSamples, 2);
+	m_maxError = maxError;
+	m_sampleMapFilename = sampleMapFilename;
+}
+
+void SamplerIntegrator::setCheckpoint(const std::string& filename, Float interval, bool resume)
+{
+	CHECK_GE(interval, 0);
+	m_progressive = true;
+	m_checkpointFilename = filename;
+	m_checkpointInterval = interval;
+	m_resume = resume;
+}
+
+void SamplerIntegrator::setProgressive(Float timeBudget, Float snapshotInterval, const std::string& snapshotFilename)
+{
+	CHECK_GE(timeBudget, 0);
+	CHECK_GE(snapshotInterval, 0);
+	m_progressive = true;
+	m_timeBudget = timeBudget;
+	m_snapshotInterval = snapshotInterval;
+	m_snapshotFilename = snapshotFilename;
+}
+
+bool SamplerIntegrator::pixelConverged(const FilmTile& filmTile, const Vector2i& pixel, int64_t nSamples) const
+{
+	if (!adaptiveSampling() || nSamples < m_minSamples)
+		return false;
+	return filmTile.getRelativeError(pixel) <= m_maxError;
+}
+
+Spectrum SamplerIntegrator::primaryLi(const Ray& ray, SurfaceInteraction* isect, const Scene& scene,
+	Sampler& sampler, MemoryArena& arena) const
+{
+	return Li(ray, scene, sampler, arena);
+}
+
 void SamplerIntegrator::render(const Scene& scene)
 {
 	Vector2i resolution = m_camera->m_film->getResolution();
@@ -19,32 +153,112 @@ void SamplerIntegrator::render(const Scene& scene)
 	// Compute number of tiles, _nTiles_, to use for parallel rendering
 	Bounds2i sampleBounds = m_camera->m_film->getSampleBounds();
 	Vector2i sampleExtent = sampleBounds.diagonal();
-	constexpr int tileSize = 16;
+	const int tileSize = m_tileSize;
 	Vector2i nTiles((sampleExtent.x + tileSize - 1) / tileSize, (sampleExtent.y + tileSize - 1) / tileSize);
+	const std::vector<int> tileOrder = computeTileOrder(nTiles, m_tileOrder);
 
-	Reporter reporter(nTiles.x * nTiles.y, "Rendering");
-	parallelFor((size_t)0, (size_t)(nTiles.x * nTiles.y), (size_t)1, [&](const tbb::blocked_range<size_t>& range)
+	// Render the samples [firstSample, endSample) of every pixel in tile _t_, tiles are
+	// identified by their row-major index whatever order they are rendered in
+	auto renderTile = [&](int t, int pass, int64_t firstSample, int64_t endSample) -> const FilmTile&
 		{
-			for (size_t t = range.begin(); t != range.end(); ++t)
+			Vector2i tile(t % nTiles.x, t / nTiles.x);
+			RenderWorker& worker = m_workers.local();
+			MemoryArena& arena = worker.arena;
+			int64_t allocations = worker.allocations;
+			if (arena.TotalAllocated() == 0)
 			{
-				Vector2i tile(t % nTiles.x, t / nTiles.x);
-				MemoryArena arena;
+				// Pull in the first arena block up front instead of at the first hit
+				arena.Alloc(1);
+				arena.Reset();
+				++worker.allocations;
+			}
+			size_t arenaSize = arena.TotalAllocated();
 
-				// Get sampler instance for tile
-				int seed = /*tile.y * nTiles.x + tile.x*/t;
-				std::unique_ptr<Sampler> tileSampler = sampler->clone(seed);
+			// Get sampler instance for tile
+			//Note: every progressive pass draws from its own random sequences
+			int seed = t + pass * nTiles.x * nTiles.y;
+			if (worker.prototype != sampler.get())
+			{
+				worker.prototype = sampler.get();
+				worker.sampler = sampler->clone(seed);
+				worker.cameraSampler = sampler->clone(seed);
+				worker.allocations += 2;
+			}
+			worker.sampler->reseed(seed);
+			worker.cameraSampler->reseed(seed);
+			Sampler* tileSampler = worker.sampler.get();
+
+			// Compute sample bounds for tile
+			int x0 = sampleBounds.m_pMin.x + tile.x * tileSize;
+			int x1 = glm::min(x0 + tileSize, sampleBounds.m_pMax.x);
+			int y0 = sampleBounds.m_pMin.y + tile.y * tileSize;
+			int y1 = glm::min(y0 + tileSize, sampleBounds.m_pMax.y);
+			Bounds2i tileBounds(Vector2i(x0, y0), Vector2i(x1, y1));
+			//K_INFO("Starting image tile " , tileBounds);
+
+			// Get _FilmTile_ for tile, the worker's tile storage is recycled
+			if (worker.film != m_camera->m_film.get())
+			{
+				worker.film = m_camera->m_film.get();
+				worker.filmTile = m_camera->m_film->getFilmTile(tileBounds);
+				worker.filmTile->reserve(tileSize);
+				++worker.allocations;
+			}
+			else if (m_camera->m_film->resetFilmTile(*worker.filmTile, tileBounds))
+			{
+				++worker.allocations;
+			}
+			FilmTile* filmTile = worker.filmTile.get();
 
-				// Compute sample bounds for tile
-				int x0 = sampleBounds.m_pMin.x + tile.x * tileSize;
-				int x1 = glm::min(x0 + tileSize, sampleBounds.m_pMax.x);
-				int y0 = sampleBounds.m_pMin.y + tile.y * tileSize;
-				int y1 = glm::min(y0 + tileSize, sampleBounds.m_pMax.y);
-				Bounds2i tileBounds(Vector2i(x0, y0), Vector2i(x1, y1));
-				//K_INFO("Starting image tile " , tileBounds);
+			auto addSample = [&](const Vector2i& pixel, const CameraSample& cameraSample,
+				Spectrum L, Float rayWeight)
+			{
+				// Issue warning if unexpected radiance value returned
+				if (L.hasNaNs())
+				{
+					K_ERROR(stringPrintf(
+						"Not-a-number radiance value returned "
+						"for pixel (%d, %d), sample %d. Setting to black.",
+						pixel.x, pixel.y,
+						(int)tileSampler->currentSampleNumber()));
+					L = Spectrum(0.f);
+				}
+				else if (L.y() < -1e-5)
+				{
+					K_ERROR(stringPrintf(
+						"Negative luminance value, %f, returned "
+						"for pixel (%d, %d), sample %d. Setting to black.",
+						L.y(), pixel.x, pixel.y,
+						(int)tileSampler->currentSampleNumber()));
+					L = Spectrum(0.f);
+				}
+				else if (std::isinf(L.y()))
+				{
+					K_ERROR(stringPrintf(
+						"Infinite luminance value returned "
+						"for pixel (%d, %d), sample %d. Setting to black.",
+						pixel.x, pixel.y,
+						(int)tileSampler->currentSampleNumber()));
+					L = Spectrum(0.f);
+				}
+
+				//std::cout << "Camera sample: " << cameraSample << " -> ray: " << ray << " -> L = " << L;
 
-				// Get _FilmTile_ for tile
-				std::unique_ptr<FilmTile> filmTile = m_camera->m_film->getFilmTile(tileBounds);
+				// Add camera ray's contribution to image
+				filmTile->addSample(cameraSample.pFilm, L, rayWeight);
+				filmTile->addPixelStatistics(pixel, L, rayWeight);
 
+				// Free _MemoryArena_ memory from computing image sample value
+				arena.Reset();
+			};
+
+			if (m_rayPacketSize > 1)
+			{
+				renderTilePackets(scene, tileBounds, *tileSampler, *worker.cameraSampler, *filmTile,
+					firstSample, endSample, arena, addSample);
+			}
+			else
+			{
 				// Loop over pixels in tile to render them
 				for (Vector2i pixel : tileBounds)
 				{
@@ -56,6 +270,8 @@ void SamplerIntegrator::render(const Scene& scene)
 					// debugging.
 					if (!insideExclusive(pixel, m_pixelBounds))
 						continue;
+					if (firstSample > 0)
+						tileSampler->setSampleNumber(firstSample);
 
 					do
 					{
@@ -73,60 +289,353 @@ void SamplerIntegrator::render(const Scene& scene)
 							L = Li(ray, scene, *tileSampler, arena);
 						}
 
-						// Issue warning if unexpected radiance value returned
-						if (L.hasNaNs())
-						{
-							K_ERROR(stringPrintf(
-								"Not-a-number radiance value returned "
-								"for pixel (%d, %d), sample %d. Setting to black.",
-								pixel.x, pixel.y,
-								(int)tileSampler->currentSampleNumber()));
-							L = Spectrum(0.f);
-						}
-						else if (L.y() < -1e-5)
-						{
-							K_ERROR(stringPrintf(
-								"Negative luminance value, %f, returned "
-								"for pixel (%d, %d), sample %d. Setting to black.",
-								L.y(), pixel.x, pixel.y,
-								(int)tileSampler->currentSampleNumber()));
-							L = Spectrum(0.f);
-						}
-						else if (std::isinf(L.y()))
-						{
-							K_ERROR(stringPrintf(
-								"Infinite luminance value returned "
-								"for pixel (%d, %d), sample %d. Setting to black.",
-								pixel.x, pixel.y,
-								(int)tileSampler->currentSampleNumber()));
-							L = Spectrum(0.f);
-						}
+						addSample(pixel, cameraSample, L, rayWeight);
 
-						//std::cout << "Camera sample: " << cameraSample << " -> ray: " << ray << " -> L = " << L;
+					} while (!pixelConverged(*filmTile, pixel, tileSampler->currentSampleNumber() + 1) &&
+						tileSampler->startNextSample() && tileSampler->currentSampleNumber() < endSample);
+				}
+			}
+			//K_INFO("Finished image tile ",tileBounds);
 
-						// Add camera ray's contribution to image
-						filmTile->addSample(cameraSample.pFilm, L, rayWeight);
+			// The arena only grows when a tile needs more scratch memory than any before
+			if (arena.TotalAllocated() != arenaSize)
+				++worker.allocations;
+			if (worker.tilesRendered++ > 0)
+				worker.steadyAllocations += worker.allocations - allocations;
 
-						// Free _MemoryArena_ memory from computing image sample value
-						arena.Reset();
+			return *filmTile;
+		};
 
-					} while (tileSampler->startNextSample());
+	auto startTime = std::chrono::steady_clock::now();
+	scene.resetRayCount();
+	if (m_progressive)
+	{
+		renderProgressive(tileOrder, renderTile);
+	}
+	else
+	{
+		Reporter reporter(nTiles.x * nTiles.y, "Rendering");
+		parallelFor((size_t)0, (size_t)(nTiles.x * nTiles.y), (size_t)1, [&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t i = range.begin(); i != range.end(); ++i)
+				{
+					m_camera->m_film->mergeFilmTile(renderTile(tileOrder[i], 0, 0, sampler->samplesPerPixel));
+					reporter.update();
 				}
-				//K_INFO("Finished image tile ",tileBounds);
+			}, ExecutionPolicy::APARALLEL);
+		reporter.done();
+	}
 
-				m_camera->m_film->mergeFilmTile(std::move(filmTile));
-				reporter.update();
-			}
-		}, ExecutionPolicy::APARALLEL);
+	m_camera->m_film->mergeSplats();
+	K_INFO("Rendering finished");
 
-	reporter.done();
+	Float elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - startTime).count();
+	int64_t nRays = scene.getRayCount();
+	K_INFO(stringPrintf("Traced %lld rays in %.0f ms (%.2f M rays/s)",
+		(long long)nRays, elapsed, elapsed > 0 ? nRays / (elapsed * 1000.f) : 0.f));
 
-	K_INFO("Rendering finished");
+	// Steady state tiles are expected to allocate nothing
+	int64_t nAllocations = 0, nSteadyAllocations = 0;
+	for (const RenderWorker& worker : m_workers)
+	{
+		nAllocations += worker.allocations;
+		nSteadyAllocations += worker.steadyAllocations;
+	}
+	K_INFO(stringPrintf("Worker pools: %d workers, %lld allocations, %lld after the first tile of a worker",
+		(int)m_workers.size(), (long long)nAllocations, (long long)nSteadyAllocations));
+
+	if (adaptiveSampling())
+	{
+		K_INFO(stringPrintf("Adaptive sampling took %.2f samples per pixel on average (%d - %lld)",
+			m_camera->m_film->getAverageSampleCount(), m_minSamples, (long long)sampler->samplesPerPixel));
+	}
+	if (!m_sampleMapFilename.empty())
+		m_camera->m_film->writeSampleCountToFile(m_sampleMapFilename);
 
 	m_camera->m_film->writeImageToFile();
 
 }
 
+template <typename RenderTile>
+void SamplerIntegrator::renderProgressive(const std::vector<int>& tileOrder, RenderTile& renderTile)
+{
+	const int nTiles = (int)tileOrder.size();
+	const int64_t targetSpp = m_sampler->samplesPerPixel;
+	if (m_maxError > 0)
+		K_WARN("Adaptive sampling is disabled by progressive rendering, every pass takes all its samples");
+
+	// Every pass takes as many samples as all the previous passes together
+	std::vector<std::pair<int64_t, int64_t>> passes;
+	for (int64_t firstSample = 0; firstSample < targetSpp; firstSample = passes.back().second)
+	{
+		int64_t endSample = glm::min(targetSpp, glm::max(2 * firstSample, (int64_t)1));
+		passes.push_back(std::make_pair(firstSample, endSample));
+	}
+
+	// Pick up where an interrupted render stopped
+	FilmCheckpoint checkpoint;
+	checkpoint.extent = m_camera->m_film->getCroppedPixelBounds().diagonal();
+	checkpoint.samplesPerPixel = targetSpp;
+	checkpoint.nTiles = nTiles;
+	checkpoint.tilesDone.assign(nTiles, 0);
+	if (m_resume && !m_checkpointFilename.empty())
+	{
+		FilmCheckpoint saved;
+		if (!saved.read(m_checkpointFilename))
+		{
+			K_INFO(stringPrintf("No checkpoint to resume from at %s", m_checkpointFilename.c_str()));
+		}
+		else if (saved.extent != checkpoint.extent || saved.samplesPerPixel != targetSpp ||
+			saved.nTiles != nTiles || saved.pass > (int)passes.size() ||
+			!m_camera->m_film->setPixelStates(saved.pixels))
+		{
+			K_WARN(stringPrintf("Checkpoint %s does not match the render settings, starting over",
+				m_checkpointFilename.c_str()));
+		}
+		else
+		{
+			checkpoint.pass = saved.pass;
+			checkpoint.tilesDone = saved.tilesDone;
+			K_INFO(stringPrintf("Resuming from checkpoint %s at pass %d of %d",
+				m_checkpointFilename.c_str(), (int)saved.pass, (int)passes.size()));
+		}
+	}
+
+	//Note: tiles of the current pass are merged with a ticket when checkpoints are written,
+	//      the film is copied stripe by stripe while the workers keep merging and a tile
+	//      counts as done iff the copy contains its merge. The copy is written to disk by
+	//      a background task.
+	const bool checkpointing = !m_checkpointFilename.empty();
+	std::vector<uint8_t> resumedTiles = checkpoint.tilesDone;
+	std::vector<FilmMergeTicket> tickets(checkpointing ? nTiles : 0);
+	int64_t passMergeCount = 0;
+	std::mutex checkpointWriterMutex;
+	std::future<bool> pendingCheckpoint;
+	auto writeCheckpoint = [&](bool wait)
+	{
+		std::unique_lock<std::mutex> writerLock(checkpointWriterMutex, std::defer_lock);
+		if (wait)
+			writerLock.lock();
+		else if (!writerLock.try_lock())
+			return;
+
+		if (pendingCheckpoint.valid())
+		{
+			// Never stall a worker behind a slow disk, skip this checkpoint instead
+			if (!wait && pendingCheckpoint.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+				return;
+			if (!pendingCheckpoint.get())
+				K_WARN(stringPrintf("Failed to write checkpoint %s", m_checkpointFilename.c_str()));
+		}
+
+		std::shared_ptr<FilmCheckpoint> copy = std::make_shared<FilmCheckpoint>(checkpoint);
+		std::vector<int64_t> stripeMergeCounts;
+		copy->pixels = m_camera->m_film->getPixelStates(&stripeMergeCounts);
+		for (int t = 0; t < nTiles; ++t)
+		{
+			int64_t number = tickets[t].number;
+			int32_t stripe = tickets[t].stripe;
+			copy->tilesDone[t] = resumedTiles[t] ||
+				(number >= passMergeCount && stripe >= 0 && number < stripeMergeCounts[stripe]);
+		}
+		const std::string filename = m_checkpointFilename;
+		pendingCheckpoint = std::async(std::launch::async, [copy, filename]() { return copy->write(filename); });
+
+		if (wait && !pendingCheckpoint.get())
+			K_WARN(stringPrintf("Failed to write checkpoint %s", m_checkpointFilename.c_str()));
+	};
+
+	auto startTime = std::chrono::steady_clock::now();
+	auto elapsedMS = [&]() -> int64_t
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::steady_clock::now() - startTime).count();
+	};
+	const int64_t deadlineMS = (int64_t)(m_timeBudget * 1000);
+	const int64_t snapshotIntervalMS = (int64_t)(m_snapshotInterval * 1000);
+	std::atomic<int64_t> nextSnapshotMS(snapshotIntervalMS);
+	const int64_t checkpointIntervalMS = m_checkpointFilename.empty() ? 0 : (int64_t)(m_checkpointInterval * 1000);
+	std::atomic<int64_t> nextCheckpointMS(checkpointIntervalMS);
+	std::atomic<bool> deadlineReached(false);
+
+	std::mutex snapshotMutex;
+	auto writeSnapshot = [&]()
+	{
+		// Skip the snapshot if another worker is still writing one
+		std::unique_lock<std::mutex> lock(snapshotMutex, std::try_to_lock);
+		if (!lock.owns_lock())
+			return;
+		m_camera->m_film->writeImageToFile(m_snapshotFilename.empty() ?
+			m_camera->m_film->getFilename() : m_snapshotFilename);
+	};
+
+	// Claims the next slot of a periodic event for the calling worker
+	auto claimInterval = [&](std::atomic<int64_t>& nextMS, int64_t intervalMS) -> bool
+	{
+		int64_t dueMS = nextMS;
+		return intervalMS > 0 && elapsedMS() >= dueMS &&
+			nextMS.compare_exchange_strong(dueMS, elapsedMS() + intervalMS);
+	};
+
+	const size_t firstPass = checkpoint.pass;
+	int64_t remainingTiles = (int64_t)nTiles * (int64_t)(passes.size() - firstPass);
+	if (firstPass < passes.size())
+		remainingTiles -= std::count(checkpoint.tilesDone.begin(), checkpoint.tilesDone.end(), 1);
+
+	Reporter reporter(remainingTiles, "Rendering");
+	size_t passesDone = firstPass;
+	for (size_t pass = firstPass; pass < passes.size() && !deadlineReached; ++pass)
+	{
+		parallelFor((size_t)0, (size_t)nTiles, (size_t)1, [&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t i = range.begin(); i != range.end(); ++i)
+				{
+					const int t = tileOrder[i];
+					if (deadlineMS > 0 && elapsedMS() >= deadlineMS)
+						deadlineReached = true;
+					if (deadlineReached)
+						return;
+					if (resumedTiles[t])
+						continue;
+
+					const FilmTile& filmTile =
+						renderTile(t, (int)pass, passes[pass].first, passes[pass].second);
+					if (checkpointing)
+						m_camera->m_film->mergeFilmTile(filmTile, tickets[t]);
+					else
+						m_camera->m_film->mergeFilmTile(filmTile);
+					reporter.update();
+
+					bool snapshotDue = claimInterval(nextSnapshotMS, snapshotIntervalMS);
+					if (m_snapshotRequested.exchange(false) || snapshotDue)
+						writeSnapshot();
+					if (claimInterval(nextCheckpointMS, checkpointIntervalMS))
+						writeCheckpoint(false);
+				}
+			}, ExecutionPolicy::APARALLEL);
+
+		if (!deadlineReached)
+		{
+			// The merges of earlier passes no longer mark tiles as done
+			passesDone = pass + 1;
+			checkpoint.pass = (int32_t)passesDone;
+			std::fill(resumedTiles.begin(), resumedTiles.end(), 0);
+			passMergeCount = m_camera->m_film->getMergeCount();
+		}
+	}
+	reporter.done();
+
+	if (!m_checkpointFilename.empty())
+		writeCheckpoint(true);
+
+	int64_t spp = passesDone > 0 ? passes[passesDone - 1].second : 0;
+	if (deadlineReached)
+	{
+		K_INFO(stringPrintf("Progressive rendering stopped at the %.1f s deadline after %d of %d passes "
+			"(%lld spp)", m_timeBudget, (int)passesDone, (int)passes.size(), (long long)spp));
+	}
+	else
+	{
+		K_INFO(stringPrintf("Progressive rendering finished %d passes (%lld spp)",
+			(int)passes.size(), (long long)spp));
+	}
+}
+
+template <typename AddSample>
+void SamplerIntegrator::renderTilePackets(const Scene& scene, const Bounds2i& tileBounds,
+	Sampler& tileSampler, Sampler& cameraSampler, const FilmTile& filmTile,
+	int64_t firstSample, int64_t endSample, MemoryArena& arena, AddSample& addSample) const
+{
+	//Note: the camera sampler walks the tile ahead of the shading sampler and generates
+	//      the camera rays of a packet, the shading sampler then visits the same pixels
+	//      and samples in the same order so deterministic samplers see the same sequence.
+	struct PacketSample
+	{
+		Vector2i pixel;
+		CameraSample cameraSample;
+		Float rayWeight;
+		bool firstInPixel;
+	};
+	PacketSample samples[MaxRayPacketSize];
+	Ray rays[MaxRayPacketSize];
+	SurfaceInteraction isects[MaxRayPacketSize];
+	int nSamples = 0;
+
+	auto flushPacket = [&]()
+	{
+		uint32_t hitMask = scene.hit(rays, nSamples, isects);
+
+		// Unpack the packet into per-sample shading
+		for (int i = 0; i < nSamples; ++i)
+		{
+			const PacketSample& sample = samples[i];
+			if (sample.firstInPixel)
+			{
+				tileSampler.startPixel(sample.pixel);
+				if (firstSample > 0)
+					tileSampler.setSampleNumber(firstSample);
+			}
+			else
+				tileSampler.startNextSample();
+
+			// Consume the camera dimensions so that shading uses the same ones as Li()
+			tileSampler.getCameraSample(sample.pixel);
+
+			Spectrum L(0.f);
+			if (sample.rayWeight > 0)
+			{
+				L = primaryLi(rays[i], (hitMask & (1u << i)) ? &isects[i] : nullptr,
+					scene, tileSampler, arena);
+			}
+			addSample(sample.pixel, sample.cameraSample, L, sample.rayWeight);
+		}
+		nSamples = 0;
+	};
+
+	for (Vector2i pixel : tileBounds)
+	{
+		cameraSampler.startPixel(pixel);
+		if (!insideExclusive(pixel, m_pixelBounds))
+			continue;
+		if (firstSample > 0)
+			cameraSampler.setSampleNumber(firstSample);
+
+		bool firstInPixel = true;
+		int64_t nextConvergenceCheck = m_minSamples;
+		do
+		{
+			PacketSample& sample = samples[nSamples];
+			sample.pixel = pixel;
+			sample.cameraSample = cameraSampler.getCameraSample(pixel);
+			sample.firstInPixel = firstInPixel;
+			firstInPixel = false;
+
+			rays[nSamples] = Ray();
+			sample.rayWeight = m_camera->castingRay(sample.cameraSample, rays[nSamples]);
+			if (++nSamples == m_rayPacketSize)
+				flushPacket();
+
+			// Adaptive sampling needs the radiance of the pending samples before going on,
+			// the pixel is only tested once per packet worth of samples so that the packets
+			// in between stay full.
+			int64_t nPixelSamples = cameraSampler.currentSampleNumber() + 1;
+			if (adaptiveSampling() && nPixelSamples >= nextConvergenceCheck)
+			{
+				nextConvergenceCheck = nPixelSamples + m_rayPacketSize;
+				if (nSamples > 0)
+					flushPacket();
+				if (pixelConverged(filmTile, pixel, nPixelSamples))
+					break;
+			}
+
+		} while (cameraSampler.startNextSample() && cameraSampler.currentSampleNumber() < endSample);
+	}
+
+	if (nSamples > 0)
+		flushPacket();
+}
+
 Spectrum SamplerIntegrator::specularReflect(const Ray& ray, const SurfaceInteraction& isect,
 	const Scene& scene, Sampler& sampler, MemoryArena& arena, int depth) const
 {
@@ -178,18 +687,32 @@ Spectrum SamplerIntegrator::specularTransmit(const Ray& ray, const SurfaceIntera
 Spectrum WhittedIntegrator::Li(const Ray& ray, const Scene& scene,
 	Sampler& sampler, MemoryArena& arena, int depth) const
 {
-	Spectrum L(0.);
-
 	SurfaceInteraction isect;
+	bool hit = scene.hit(ray, isect);
+	return shade(ray, hit ? &isect : nullptr, scene, sampler, arena, depth);
+}
+
+Spectrum WhittedIntegrator::primaryLi(const Ray& ray, SurfaceInteraction* isect, const Scene& scene,
+	Sampler& sampler, MemoryArena& arena) const
+{
+	return shade(ray, isect, scene, sampler, arena, 0);
+}
+
+Spectrum WhittedIntegrator::shade(const Ray& ray, SurfaceInteraction* hit, const Scene& scene,
+	Sampler& sampler, MemoryArena& arena, int depth) const
+{
+	Spectrum L(0.);
 
 	// No intersection found, just return lights emission
-	if (!scene.hit(ray, isect))
+	if (hit == nullptr)
 	{
 		for (const auto& light : scene.m_lights)
 			L += light->Le(ray);
 		return L;
 	}
 
+	SurfaceInteraction& isect = *hit;
+
 	// Compute emitted and reflected light at ray intersection point
 
 	// Initialize common variables for Whitted integrator
@@ -356,7 +879,7 @@ Spectrum estimateDirect(const Interaction& it, const Vector2f& uScattering, cons
 		// Sample scattered direction for surface interactions
 		BxDFType sampledType = BxDFType::BSDF_ALL;
 		const SurfaceInteraction& isect = (const SurfaceInteraction&)it;
-		f = isect.bsdf->sample_f(isect.wo, wi, uScattering, scatteringPdf, bsdfFlags, sampledType);
+		f = isect.bsdf->sample_f(isect.wo, wi, uScattering, scatteringPdf, sampledType, bsdfFlags);
 		f *= absDot(wi, isect.normal);
 		sampledSpecular = (sampledType & BSDF_SPECULAR) != 0;
 
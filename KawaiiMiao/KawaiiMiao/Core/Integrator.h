@@ -5,6 +5,10 @@
 #include "Sampling.h"
 #include "Camera.h"
 #include "Primitive.h"
+#include "../Tool/Memory.h"
+
+#include <atomic>
+#include <tbb/tbb/enumerable_thread_specific.h>
 
 RENDER_BEGIN
 
@@ -17,6 +21,28 @@ public:
 	virtual void render(const Scene& scene) = 0;
 };
 
+//Note: per-worker state reused across tiles and frames, the steady state of a render
+//      constructs no arenas, samplers or tile buffers.
+struct RenderWorker
+{
+	MemoryArena arena;
+	const Sampler* prototype = nullptr;		//sampler the pooled samplers were cloned from
+	std::unique_ptr<Sampler> sampler;
+	std::unique_ptr<Sampler> cameraSampler;
+	const Film* film = nullptr;				//film the pooled tile belongs to
+	std::unique_ptr<FilmTile> filmTile;
+
+	int64_t tilesRendered = 0;
+	int64_t allocations = 0;
+	int64_t steadyAllocations = 0;			//allocations after the worker's first tile
+};
+
+//Note: order in which the tiles of a pass are handed out. Consecutive tiles of the space
+//      filling curves are spatial neighbours, the ranges concurrent workers pick up stay
+//      compact and touch fewer distinct parts of the scene. Spiral starts at the image
+//      center for early feedback of progressive rendering.
+enum class TileOrder { RowMajor, Morton, Hilbert, Spiral };
+
 class SamplerIntegrator : public Integrator
 {
 public:
@@ -32,6 +58,36 @@ public:
 	virtual Spectrum Li(const Ray& ray, const Scene& scene,
 		Sampler& sampler, MemoryArena& arena, int depth = 0) const = 0;
 
+	// Radiance along a camera ray whose first intersection was already found by packet
+	// tracing, _isect_ is nullptr if the ray escaped. The default traces the ray again.
+	virtual Spectrum primaryLi(const Ray& ray, SurfaceInteraction* isect, const Scene& scene,
+		Sampler& sampler, MemoryArena& arena) const;
+
+	//Note: 1 traces camera rays one by one, 4/8/16 traces them as coherent packets
+	void setRayPacketSize(int packetSize);
+
+	void setTiling(TileOrder order, int tileSize);
+
+	//Note: adaptive sampling takes at least _minSamples_ per pixel and then stops once the
+	//      relative error of the pixel luminance drops below _maxError_, the sampler's
+	//      samplesPerPixel becomes the upper bound. 0 disables it. The per-pixel sample
+	//      count is written to _sampleMapFilename_ when it is not empty.
+	void setAdaptiveSampling(int minSamples, Float maxError, const std::string& sampleMapFilename = "");
+
+	//Note: progressive rendering accumulates passes of 1, 1, 2, 4, ... samples per pixel into
+	//      the film until the sampler's samplesPerPixel is reached or _timeBudget_ seconds
+	//      have passed (0 -> no deadline), tiles already started when the deadline hits are
+	//      finished. Every _snapshotInterval_ seconds (0 -> never) and on requestSnapshot()
+	//      one worker writes the current image to _snapshotFilename_ while the others go on.
+	void setProgressive(Float timeBudget, Float snapshotInterval = 0, const std::string& snapshotFilename = "");
+	//Note: progressive rendering checkpoints the film and the pass in flight to _filename_
+	//      every _interval_ seconds (0 -> only when it stops), the file is written by a
+	//      background task. With _resume_ a matching checkpoint is loaded first and only
+	//      the remaining samples are rendered. Enables progressive rendering.
+	void setCheckpoint(const std::string& filename, Float interval, bool resume);
+	//Note: safe to call from any thread or a signal handler
+	void requestSnapshot() { m_snapshotRequested = true; }
+
 	Spectrum specularReflect(const Ray& ray, const SurfaceInteraction& isect,
 		const Scene& scene, Sampler& sampler, MemoryArena& arena, int depth) const;
 
@@ -39,11 +95,44 @@ public:
 		const Scene& scene, Sampler& sampler, MemoryArena& arena, int depth) const;
 
 protected:
-	Camera::ptr m_camera;
+	// Row-major indices of the tiles in the order they are handed out
+	static std::vector<int> computeTileOrder(const Vector2i& nTiles, TileOrder order);
 
-private:
+	Camera::ptr m_camera;
 	Sampler::ptr m_sampler;
 	const Bounds2i m_pixelBounds;
+	TileOrder m_tileOrder = TileOrder::Hilbert;
+	int m_tileSize = 16;
+
+private:
+	template <typename AddSample>
+	void renderTilePackets(const Scene& scene, const Bounds2i& tileBounds, Sampler& tileSampler,
+		Sampler& cameraSampler, const FilmTile& filmTile, int64_t firstSample,
+		int64_t endSample, MemoryArena& arena, AddSample& addSample) const;
+
+	template <typename RenderTile>
+	void renderProgressive(const std::vector<int>& tileOrder, RenderTile& renderTile);
+
+	// Progressive passes always take all their samples, adaptive sampling only applies to one-shot renders
+	bool adaptiveSampling() const { return m_maxError > 0 && !m_progressive; }
+	bool pixelConverged(const FilmTile& filmTile, const Vector2i& pixel, int64_t nSamples) const;
+
+	int m_rayPacketSize = 1;
+
+	int m_minSamples = 0;
+	Float m_maxError = 0;
+	std::string m_sampleMapFilename;
+
+	bool m_progressive = false;
+	Float m_timeBudget = 0;
+	Float m_snapshotInterval = 0;
+	std::string m_snapshotFilename;
+	std::atomic<bool> m_snapshotRequested{ false };
+	std::string m_checkpointFilename;
+	Float m_checkpointInterval = 0;
+	bool m_resume = false;
+
+	tbb::enumerable_thread_specific<RenderWorker> m_workers;
 };
 
 class WhittedIntegrator : public SamplerIntegrator
@@ -57,7 +146,13 @@ public:
 	virtual Spectrum Li(const Ray& ray, const Scene& scene,
 		Sampler& sampler, MemoryArena& arena, int depth) const override;
 
+	virtual Spectrum primaryLi(const Ray& ray, SurfaceInteraction* isect, const Scene& scene,
+		Sampler& sampler, MemoryArena& arena) const override;
+
 private:
+	Spectrum shade(const Ray& ray, SurfaceInteraction* hit, const Scene& scene,
+		Sampler& sampler, MemoryArena& arena, int depth) const;
+
 	const int m_maxDepth;
 };
 
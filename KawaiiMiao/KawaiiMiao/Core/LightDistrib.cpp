@@ -0,0 +1,19 @@
+#include "LightDistrib.h"
+
+#include "Scene.h"
+#include "Light.h"
+
+RENDER_BEGIN
+
+std::unique_ptr<Distribution1D> computeLightPowerDistribution(const Scene& scene)
+{
+	if (scene.m_lights.empty())
+		return nullptr;
+
+	std::vector<Float> lightPower;
+	for (const auto& light : scene.m_lights)
+		lightPower.push_back(light->power().y());
+	return std::unique_ptr<Distribution1D>(new Distribution1D(&lightPower[0], (int)lightPower.size()));
+}
+
+RENDER_END
\ No newline at end of file
@@ -89,4 +89,8 @@ public:
 	Float funcInt;
 };
 
+//Note: picks lights proportionally to their emitted power, so that bright lights get
+//      most of the shadow rays. Returns nullptr if the scene has no light.
+std::unique_ptr<Distribution1D> computeLightPowerDistribution(const Scene& scene);
+
 RENDER_END
\ No newline at end of file
@@ -0,0 +1,339 @@
+#include "MeshLoader.h"
+
+#include "../Tool/MappedFile.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sys/stat.h>
+#include <tbb/tbb/parallel_for.h>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+RENDER_BEGIN
+
+//Note: cache layout -> header, one entry per mesh, then the raw arrays of every mesh.
+//      Each array starts on a 16 byte boundary so that it can be used in place.
+struct MeshCacheHeader
+{
+	char magic[4];
+	uint32_t version;
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	uint32_t nMeshes;
+	uint32_t reserved;
+};
+
+struct MeshCacheEntry
+{
+	int32_t nTriangles;
+	int32_t nVertices;
+	int32_t materialIndex;
+	int32_t reserved;
+	uint64_t indicesOffset;
+	uint64_t pOffset;
+	uint64_t nOffset;		//0 -> no normals
+	uint64_t uvOffset;		//0 -> no uvs
+};
+
+static const char meshCacheMagic[4] = { 'K', 'M', 'M', 'C' };
+static const uint32_t meshCacheVersion = 1;
+
+static uint64_t alignCacheOffset(uint64_t offset) { return (offset + 15) & ~uint64_t(15); }
+
+//Note: size and modification time of the source model, a stale cache is rebuilt.
+static bool getSourceStamp(const std::string& path, uint64_t& size, int64_t& time)
+{
+#if defined(_WIN32)
+	struct _stat64 st;
+	if (_stat64(path.c_str(), &st) != 0)
+		return false;
+#else
+	struct stat st;
+	if (stat(path.c_str(), &st) != 0)
+		return false;
+#endif
+	size = (uint64_t)st.st_size;
+	time = (int64_t)st.st_mtime;
+	return true;
+}
+
+//Note: buffers of a mesh imported by Assimp, the MeshData arrays point into them.
+struct MeshBuffers
+{
+	std::vector<int> indices;
+	std::vector<Vector3f> p;
+	std::vector<Vector3f> n;
+	std::vector<Vector2f> uv;
+};
+
+std::vector<MeshData> MeshLoader::load(const std::string& path, bool useCache)
+{
+	auto startTime = std::chrono::system_clock::now();
+	auto elapsedMs = [&startTime]() -> Float
+	{
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+			std::chrono::system_clock::now() - startTime).count();
+	};
+
+	std::vector<MeshData> meshes;
+	const std::string cachePath = getCachePath(path);
+	if (useCache && readCache(path, meshes))
+	{
+		K_INFO(stringPrintf("Mapped %d meshes of %s from cache in %.0f ms",
+			(int)meshes.size(), path.c_str(), elapsedMs()));
+		return meshes;
+	}
+
+	meshes = importAssimp(path);
+	if (meshes.empty())
+		return meshes;
+
+	int64_t nTriangles = 0;
+	for (const auto& mesh : meshes)
+		nTriangles += mesh.nTriangles;
+	K_INFO(stringPrintf("Imported %d meshes (%lld triangles) of %s in %.0f ms",
+		(int)meshes.size(), (long long)nTriangles, path.c_str(), elapsedMs()));
+
+	if (useCache && !writeCache(path, meshes))
+		K_WARN(stringPrintf("Failed to write mesh cache %s", cachePath.c_str()));
+	return meshes;
+}
+
+std::vector<TriangleMesh::ptr> MeshLoader::createMeshes(const std::vector<MeshData>& meshes,
+	const Transform& objectToWorld, const Material::ptr& material)
+{
+	std::vector<TriangleMesh::ptr> triMeshes;
+	triMeshes.reserve(meshes.size());
+	for (const auto& mesh : meshes)
+	{
+		triMeshes.push_back(std::make_shared<TriangleMesh>(objectToWorld, mesh.nTriangles,
+			mesh.indices, mesh.nVertices, mesh.p, mesh.n, mesh.uv, material, mesh.storage));
+	}
+	return triMeshes;
+}
+
+std::vector<MeshData> MeshLoader::importAssimp(const std::string& path)
+{
+	//Note: node transforms are baked into the vertices, every mesh ends up in model space.
+	Assimp::Importer importer;
+	const aiScene* scene = importer.ReadFile(path,
+		aiProcess_Triangulate |
+		aiProcess_JoinIdenticalVertices |
+		aiProcess_PreTransformVertices |
+		aiProcess_SortByPType);
+	if (scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE))
+	{
+		K_ERROR(stringPrintf("Failed to import %s: %s", path.c_str(), importer.GetErrorString()));
+		return std::vector<MeshData>();
+	}
+
+	// Only keep the meshes that contain triangles, points and lines are dropped
+	std::vector<const aiMesh*> aiMeshes;
+	for (unsigned int i = 0; i < scene->mNumMeshes; ++i)
+	{
+		const aiMesh* mesh = scene->mMeshes[i];
+		if ((mesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE) && mesh->mNumFaces > 0)
+			aiMeshes.push_back(mesh);
+	}
+
+	// Convert the meshes to contiguous buffers in parallel
+	std::vector<MeshData> meshes(aiMeshes.size());
+	tbb::parallel_for(tbb::blocked_range<size_t>(0, aiMeshes.size()),
+		[&](const tbb::blocked_range<size_t>& range)
+	{
+		for (size_t m = range.begin(); m != range.end(); ++m)
+		{
+			const aiMesh* mesh = aiMeshes[m];
+			auto buffers = std::make_shared<MeshBuffers>();
+
+			buffers->indices.reserve(3 * mesh->mNumFaces);
+			for (unsigned int f = 0; f < mesh->mNumFaces; ++f)
+			{
+				const aiFace& face = mesh->mFaces[f];
+				if (face.mNumIndices != 3)
+					continue;
+				buffers->indices.push_back((int)face.mIndices[0]);
+				buffers->indices.push_back((int)face.mIndices[1]);
+				buffers->indices.push_back((int)face.mIndices[2]);
+			}
+
+			const unsigned int nVertices = mesh->mNumVertices;
+			buffers->p.resize(nVertices);
+			for (unsigned int v = 0; v < nVertices; ++v)
+				buffers->p[v] = Vector3f(mesh->mVertices[v].x, mesh->mVertices[v].y, mesh->mVertices[v].z);
+
+			//Note: normals are stored normalized so that they can be used in place.
+			if (mesh->HasNormals())
+			{
+				buffers->n.resize(nVertices);
+				for (unsigned int v = 0; v < nVertices; ++v)
+				{
+					Vector3f n(mesh->mNormals[v].x, mesh->mNormals[v].y, mesh->mNormals[v].z);
+					buffers->n[v] = lengthSquared(n) > 0 ? normalize(n) : n;
+				}
+			}
+
+			if (mesh->HasTextureCoords(0))
+			{
+				buffers->uv.resize(nVertices);
+				for (unsigned int v = 0; v < nVertices; ++v)
+					buffers->uv[v] = Vector2f(mesh->mTextureCoords[0][v].x, mesh->mTextureCoords[0][v].y);
+			}
+
+			MeshData& data = meshes[m];
+			data.nTriangles = (int)buffers->indices.size() / 3;
+			data.nVertices = (int)nVertices;
+			data.materialIndex = (int)mesh->mMaterialIndex;
+			data.indices = buffers->indices.data();
+			data.p = buffers->p.data();
+			data.n = buffers->n.empty() ? nullptr : buffers->n.data();
+			data.uv = buffers->uv.empty() ? nullptr : buffers->uv.data();
+			data.storage = buffers;
+		}
+	});
+
+	return meshes;
+}
+
+bool MeshLoader::readCache(const std::string& path, std::vector<MeshData>& meshes)
+{
+	auto file = std::make_shared<MappedFile>();
+	if (!file->open(getCachePath(path)))
+		return false;
+
+	const char* base = file->data();
+	const uint64_t fileSize = file->size();
+	if (fileSize < sizeof(MeshCacheHeader))
+		return false;
+
+	MeshCacheHeader header;
+	std::memcpy(&header, base, sizeof(MeshCacheHeader));
+	if (std::memcmp(header.magic, meshCacheMagic, 4) != 0 || header.version != meshCacheVersion)
+		return false;
+
+	//Note: without the source file the cache is trusted as is.
+	uint64_t sourceSize;
+	int64_t sourceTime;
+	if (getSourceStamp(path, sourceSize, sourceTime) &&
+		(sourceSize != header.sourceSize || sourceTime != header.sourceTime))
+		return false;
+
+	const uint64_t entriesEnd = sizeof(MeshCacheHeader) + (uint64_t)header.nMeshes * sizeof(MeshCacheEntry);
+	if (entriesEnd > fileSize)
+		return false;
+
+	// Point the meshes at the mapped arrays, nothing is copied
+	auto inFile = [fileSize](uint64_t offset, uint64_t bytes) -> bool
+	{
+		return offset % 16 == 0 && offset <= fileSize && bytes <= fileSize - offset;
+	};
+	std::vector<MeshData> cached(header.nMeshes);
+	for (uint32_t m = 0; m < header.nMeshes; ++m)
+	{
+		MeshCacheEntry entry;
+		std::memcpy(&entry, base + sizeof(MeshCacheHeader) + m * sizeof(MeshCacheEntry), sizeof(MeshCacheEntry));
+		const uint64_t nIndices = 3 * (uint64_t)entry.nTriangles;
+		const uint64_t nVertices = (uint64_t)entry.nVertices;
+		if (!inFile(entry.indicesOffset, nIndices * sizeof(int)) ||
+			!inFile(entry.pOffset, nVertices * sizeof(Vector3f)) ||
+			(entry.nOffset != 0 && !inFile(entry.nOffset, nVertices * sizeof(Vector3f))) ||
+			(entry.uvOffset != 0 && !inFile(entry.uvOffset, nVertices * sizeof(Vector2f))))
+			return false;
+
+		MeshData& data = cached[m];
+		data.nTriangles = entry.nTriangles;
+		data.nVertices = entry.nVertices;
+		data.materialIndex = entry.materialIndex;
+		data.indices = reinterpret_cast<const int*>(base + entry.indicesOffset);
+		data.p = reinterpret_cast<const Vector3f*>(base + entry.pOffset);
+		data.n = entry.nOffset != 0 ? reinterpret_cast<const Vector3f*>(base + entry.nOffset) : nullptr;
+		data.uv = entry.uvOffset != 0 ? reinterpret_cast<const Vector2f*>(base + entry.uvOffset) : nullptr;
+		data.storage = file;
+	}
+
+	meshes.swap(cached);
+	return true;
+}
+
+bool MeshLoader::writeCache(const std::string& path, const std::vector<MeshData>& meshes)
+{
+	MeshCacheHeader header;
+	std::memcpy(header.magic, meshCacheMagic, 4);
+	header.version = meshCacheVersion;
+	header.nMeshes = (uint32_t)meshes.size();
+	header.reserved = 0;
+	if (!getSourceStamp(path, header.sourceSize, header.sourceTime))
+		return false;
+
+	// Lay out the arrays after the header and the entry table
+	std::vector<MeshCacheEntry> entries(meshes.size());
+	uint64_t offset = sizeof(MeshCacheHeader) + meshes.size() * sizeof(MeshCacheEntry);
+	auto place = [&offset](uint64_t bytes) -> uint64_t
+	{
+		offset = alignCacheOffset(offset);
+		uint64_t start = offset;
+		offset += bytes;
+		return start;
+	};
+	for (size_t m = 0; m < meshes.size(); ++m)
+	{
+		const MeshData& mesh = meshes[m];
+		MeshCacheEntry& entry = entries[m];
+		entry.nTriangles = mesh.nTriangles;
+		entry.nVertices = mesh.nVertices;
+		entry.materialIndex = mesh.materialIndex;
+		entry.reserved = 0;
+		entry.indicesOffset = place(3 * (uint64_t)mesh.nTriangles * sizeof(int));
+		entry.pOffset = place((uint64_t)mesh.nVertices * sizeof(Vector3f));
+		entry.nOffset = mesh.n != nullptr ? place((uint64_t)mesh.nVertices * sizeof(Vector3f)) : 0;
+		entry.uvOffset = mesh.uv != nullptr ? place((uint64_t)mesh.nVertices * sizeof(Vector2f)) : 0;
+	}
+
+	//Note: written to a temporary file first so that a crash never leaves a truncated cache.
+	const std::string cachePath = getCachePath(path);
+	const std::string tmpPath = cachePath + ".tmp";
+	{
+		std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!out)
+			return false;
+
+		uint64_t written = 0;
+		auto write = [&out, &written](const void* data, uint64_t bytes)
+		{
+			out.write(static_cast<const char*>(data), (std::streamsize)bytes);
+			written += bytes;
+		};
+		auto writeAt = [&](uint64_t at, const void* data, uint64_t bytes)
+		{
+			static const char zeros[16] = {};
+			DCHECK(at >= written && at - written < 16);
+			write(zeros, at - written);
+			write(data, bytes);
+		};
+
+		write(&header, sizeof(MeshCacheHeader));
+		write(entries.data(), entries.size() * sizeof(MeshCacheEntry));
+		for (size_t m = 0; m < meshes.size(); ++m)
+		{
+			const MeshData& mesh = meshes[m];
+			const MeshCacheEntry& entry = entries[m];
+			writeAt(entry.indicesOffset, mesh.indices, 3 * (uint64_t)mesh.nTriangles * sizeof(int));
+			writeAt(entry.pOffset, mesh.p, (uint64_t)mesh.nVertices * sizeof(Vector3f));
+			if (mesh.n != nullptr)
+				writeAt(entry.nOffset, mesh.n, (uint64_t)mesh.nVertices * sizeof(Vector3f));
+			if (mesh.uv != nullptr)
+				writeAt(entry.uvOffset, mesh.uv, (uint64_t)mesh.nVertices * sizeof(Vector2f));
+		}
+		if (!out)
+			return false;
+	}
+
+	std::remove(cachePath.c_str());
+	return std::rename(tmpPath.c_str(), cachePath.c_str()) == 0;
+}
+
+RENDER_END
\ No newline at end of file
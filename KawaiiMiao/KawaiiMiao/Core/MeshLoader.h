@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Rendering.h"
+#include "TriangleMesh.h"
+#include "../Math/KMathUtil.h"
+
+#include <string>
+#include <vector>
+
+RENDER_BEGIN
+
+//Note: object space geometry of one imported mesh. The arrays point either into a
+//      memory mapped cache file or into buffers owned by the loader, in both cases
+//      they stay valid as long as _storage_ is alive.
+struct MeshData
+{
+	int nTriangles = 0;
+	int nVertices = 0;
+	int materialIndex = 0;
+	const int* indices = nullptr;
+	const Vector3f* p = nullptr;
+	const Vector3f* n = nullptr;		//nullptr -> no normals
+	const Vector2f* uv = nullptr;		//nullptr -> no uvs
+	std::shared_ptr<const void> storage;
+};
+
+class MeshLoader
+{
+public:
+	// Loads all meshes of a model file (OBJ, FBX, ...). The first load goes through Assimp
+	// and writes a binary cache next to the file, later loads map the cache and skip Assimp.
+	static std::vector<MeshData> load(const std::string& path, bool useCache = true);
+
+	// One TriangleMesh per loaded mesh, the loaded buffers are shared instead of copied
+	// whenever _objectToWorld_ is the identity.
+	static std::vector<TriangleMesh::ptr> createMeshes(const std::vector<MeshData>& meshes,
+		const Transform& objectToWorld, const Material::ptr& material);
+
+	static std::string getCachePath(const std::string& path) { return path + ".kmcache"; }
+
+private:
+	static std::vector<MeshData> importAssimp(const std::string& path);
+	static bool readCache(const std::string& path, std::vector<MeshData>& meshes);
+	static bool writeCache(const std::string& path, const std::vector<MeshData>& meshes);
+};
+
+RENDER_END
\ No newline at end of file
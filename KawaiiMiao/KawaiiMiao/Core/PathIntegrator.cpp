@@ -0,0 +1,118 @@
+#include "PathIntegrator.h"
+
+#include "BSDF.h"
+#include "Scene.h"
+#include "Interaction.h"
+
+RENDER_BEGIN
+
+PathIntegrator::PathIntegrator(int maxDepth, Camera::ptr camera, Sampler::ptr sampler,
+	const Bounds2i& pixelBounds, Float rrThreshold)
+	: SamplerIntegrator(camera, sampler, pixelBounds), m_maxDepth(maxDepth), m_rrThreshold(rrThreshold) {}
+
+void PathIntegrator::preprocess(const Scene& scene, Sampler& sampler)
+{
+	m_lightDistrib = computeLightPowerDistribution(scene);
+}
+
+Spectrum PathIntegrator::Li(const Ray& ray, const Scene& scene,
+	Sampler& sampler, MemoryArena& arena, int depth) const
+{
+	return tracePath(ray, nullptr, false, scene, sampler, arena);
+}
+
+Spectrum PathIntegrator::primaryLi(const Ray& ray, SurfaceInteraction* isect, const Scene& scene,
+	Sampler& sampler, MemoryArena& arena) const
+{
+	return tracePath(ray, isect, true, scene, sampler, arena);
+}
+
+Spectrum PathIntegrator::tracePath(const Ray& cameraRay, SurfaceInteraction* primaryHit, bool primaryTraced,
+	const Scene& scene, Sampler& sampler, MemoryArena& arena) const
+{
+	Spectrum L(0.f), beta(1.f);
+	Ray ray(cameraRay);
+	bool specularBounce = false;
+
+	//Note: the path throughput _beta_ replaces the recursion of the Whitted integrator,
+	//      every vertex costs one shadow ray and one continuation ray at most.
+	for (int bounces = 0;; ++bounces)
+	{
+		// Find next path vertex, the first one may come from packet tracing
+		SurfaceInteraction isect;
+		bool foundIntersection;
+		if (bounces == 0 && primaryTraced)
+		{
+			foundIntersection = primaryHit != nullptr;
+			if (foundIntersection)
+				isect = *primaryHit;
+		}
+		else
+			foundIntersection = scene.hit(ray, isect);
+
+		// Possibly add emitted light at intersection
+		if (bounces == 0 || specularBounce)
+		{
+			// Add emitted light at path vertex or from the environment
+			if (foundIntersection)
+			{
+				L += beta * isect.Le(-ray.direction());
+			}
+			else
+			{
+				for (const auto& light : scene.m_infiniteLights)
+					L += beta * light->Le(ray);
+			}
+		}
+
+		// Terminate path if ray escaped or _maxDepth_ was reached
+		if (!foundIntersection || bounces >= m_maxDepth)
+			break;
+
+		// Compute scattering functions and skip over medium boundaries
+		isect.computeScatteringFunctions(ray, arena, true);
+		if (!isect.bsdf)
+		{
+			ray = isect.spawnRay(ray.direction());
+			bounces--;
+			continue;
+		}
+
+		// Sample illumination from lights to find path contribution.
+		// (But skip this for perfectly specular BSDFs.)
+		if (isect.bsdf->numComponents(BxDFType(BSDF_ALL & ~BSDF_SPECULAR)) > 0)
+		{
+			Spectrum Ld = beta * uniformSampleOneLight(isect, scene, arena, sampler, m_lightDistrib.get());
+			CHECK_GE(Ld.y(), 0.f);
+			L += Ld;
+		}
+
+		// Sample BSDF to get new path direction
+		Vector3f wo = -ray.direction(), wi;
+		Float pdf = 0;
+		//Note: BSDF::sample_f() only reports the sampled type if _flags_ is non zero.
+		BxDFType flags = BSDF_ALL;
+		Spectrum f = isect.bsdf->sample_f(wo, wi, sampler.get2D(), pdf, flags, BSDF_ALL);
+		if (f.isBlack() || pdf == 0.f)
+			break;
+		beta *= f * absDot(wi, isect.normal) / pdf;
+		DCHECK(!glm::isinf(beta.y()));
+		specularBounce = (flags & BSDF_SPECULAR) != 0;
+		ray = isect.spawnRay(wi);
+
+		// Possibly terminate the path with Russian roulette
+		Float maxBeta = beta.maxComponentValue();
+		if (maxBeta < m_rrThreshold && bounces > 3)
+		{
+			Float q = glm::max((Float).05, 1 - maxBeta);
+			if (sampler.get1D() < q)
+				break;
+			beta /= 1 - q;
+			DCHECK(!glm::isinf(beta.y()));
+		}
+	}
+
+	return L;
+}
+
+RENDER_END
\ No newline at end of file
@@ -7,4 +7,32 @@
 
 RENDER_BEGIN
 
+//Note: iterative unidirectional path tracer. Direct lighting is estimated at every
+//      non-specular vertex with one light chosen by power (MIS between light and
+//      BSDF sampling), and paths are terminated with Russian roulette.
+class PathIntegrator : public SamplerIntegrator
+{
+public:
+	typedef std::shared_ptr<PathIntegrator> ptr;
+
+	PathIntegrator(int maxDepth, Camera::ptr camera, Sampler::ptr sampler,
+		const Bounds2i& pixelBounds, Float rrThreshold = 1);
+
+	virtual void preprocess(const Scene& scene, Sampler& sampler) override;
+
+	virtual Spectrum Li(const Ray& ray, const Scene& scene,
+		Sampler& sampler, MemoryArena& arena, int depth) const override;
+
+	virtual Spectrum primaryLi(const Ray& ray, SurfaceInteraction* isect, const Scene& scene,
+		Sampler& sampler, MemoryArena& arena) const override;
+
+protected:
+	Spectrum tracePath(const Ray& cameraRay, SurfaceInteraction* primaryHit, bool primaryTraced,
+		const Scene& scene, Sampler& sampler, MemoryArena& arena) const;
+
+	const int m_maxDepth;
+	const Float m_rrThreshold;
+	std::unique_ptr<Distribution1D> m_lightDistrib;
+};
+
 RENDER_END
\ No newline at end of file
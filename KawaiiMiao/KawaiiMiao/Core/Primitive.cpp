@@ -35,6 +35,8 @@ void HitableEntity::computeScatteringFunctions(SurfaceInteraction& isect, Memory
 
 Bounds3f HitableEntity::worldBound() const { return m_shape->worldBound(); }
 
+bool HitableEntity::getTriangleVertices(Vector3f p[3]) const { return m_shape->getTriangleVertices(p); }
+
 const AreaLight* HitableEntity::getAreaLight() const { return m_areaLight.get(); }
 
 const Material* HitableEntity::getMaterial() const { return m_material.get(); }
@@ -44,6 +46,30 @@ const AreaLight* HitableAggregate::getAreaLight() const { return nullptr; }
 
 const Material* HitableAggregate::getMaterial() const { return nullptr; }
 
+uint32_t HitableAggregate::hit(const Ray* rays, int nRays, SurfaceInteraction* isects) const
+{
+	CHECK_LE(nRays, MaxRayPacketSize);
+	uint32_t hitMask = 0;
+	for (int i = 0; i < nRays; ++i)
+	{
+		if (hit(rays[i], isects[i]))
+			hitMask |= 1u << i;
+	}
+	return hitMask;
+}
+
+uint32_t HitableAggregate::occluded(const Ray* rays, int nRays) const
+{
+	CHECK_LE(nRays, MaxRayPacketSize);
+	uint32_t occludedMask = 0;
+	for (int i = 0; i < nRays; ++i)
+	{
+		if (hit(rays[i]))
+			occludedMask |= 1u << i;
+	}
+	return occludedMask;
+}
+
 void HitableAggregate::computeScatteringFunctions(SurfaceInteraction& isect, MemoryArena& arena,
 	TransportMode mode, bool allowMultipleLobes) const
 {
@@ -52,6 +78,57 @@ void HitableAggregate::computeScatteringFunctions(SurfaceInteraction& isect, Mem
 		"AHitableAggregate::computeScatteringFunctions() shouldn't be "	"called";
 }
 
+// Instance
+HitableInstance::HitableInstance(const HitableAggregate::ptr& aggregate, const Transform& instanceToWorld)
+	: m_aggregate(aggregate), m_instanceToWorld(instanceToWorld),
+	m_worldBound(instanceToWorld(aggregate->worldBound()))
+{
+
+}
+
+Ray HitableInstance::toInstance(const Ray& ray, Float& scale) const
+{
+	//Note: Ray normalizes its direction, so the hit distances are rescaled by the length
+	//      of the transformed direction instead of being preserved.
+	const Matrix4x4& worldToInstance = m_instanceToWorld.getInverseMatrix();
+	Vector3f o(worldToInstance * glm::vec<4, Float>(ray.m_origin, 1.0f));
+	Vector3f d(worldToInstance * glm::vec<4, Float>(ray.m_dir, 0.0f));
+	scale = length(d);
+	return Ray(o, d, ray.m_tMax * scale);
+}
+
+bool HitableInstance::hit(const Ray& ray) const
+{
+	Float scale;
+	return m_aggregate->hit(toInstance(ray, scale));
+}
+
+bool HitableInstance::hit(const Ray& ray, SurfaceInteraction& isect) const
+{
+	Float scale;
+	Ray r = toInstance(ray, scale);
+	if (!m_aggregate->hit(r, isect))
+		return false;
+	ray.m_tMax = r.m_tMax / scale;
+
+	// Transform the interaction back to world space, normals go with the inverse transpose
+	const Matrix4x4& instanceToWorld = m_instanceToWorld.getMatrix();
+	const Matrix4x4& worldToInstance = m_instanceToWorld.getInverseMatrix();
+	isect.p = Vector3f(instanceToWorld * glm::vec<4, Float>(isect.p, 1.0f));
+	isect.dpdu = Vector3f(instanceToWorld * glm::vec<4, Float>(isect.dpdu, 0.0f));
+	isect.dpdv = Vector3f(instanceToWorld * glm::vec<4, Float>(isect.dpdv, 0.0f));
+	isect.normal = normalize(Vector3f(glm::vec<4, Float>(isect.normal, 0.0f) * worldToInstance));
+	isect.wo = -ray.direction();
+	return true;
+}
+
+void HitableInstance::computeScatteringFunctions(SurfaceInteraction& isect, MemoryArena& arena,
+	TransportMode mode, bool allowMultipleLobes) const
+{
+	//Note: should not go here, _isect.hitable_ is the hitable inside the aggregate.
+	K_ERROR("HitableInstance::computeScatteringFunctions() shouldn't be called");
+}
+
 Bounds3f HitableList::worldBound() const { return m_worldBounds; }
 
 void HitableList::addHitable(Hitable::ptr entity)
@@ -74,14 +151,14 @@ bool HitableList::hit(const Ray& ray) const
 
 bool HitableList::hit(const Ray& ray, SurfaceInteraction& ret) const
 {
-	SurfaceInteraction temp_rec;
+	//Note: a successful hit shrinks ray.m_tMax, so the hitables only overwrite
+	//      _ret_ with a closer intersection and no temporary copy is needed.
 	bool hit_anything = false;
 	for (int i = 0; i < m_hitableList.size(); i++)
 	{
-		if (m_hitableList[i]->hit(ray, temp_rec))
+		if (m_hitableList[i]->hit(ray, ret))
 		{
 			hit_anything = true;
-			ret = temp_rec;
 		}
 	}
 	return hit_anything;
@@ -18,6 +18,9 @@ public:
 	virtual bool hit(const Ray& ray) const = 0;
 	virtual bool hit(const Ray& ray, SurfaceInteraction& iset) const = 0;
 
+	//Note: see Shape::getTriangleVertices
+	virtual bool getTriangleVertices(Vector3f p[3]) const { return false; }
+
 	virtual const AreaLight* getAreaLight() const = 0;
 	virtual const Material* getMaterial() const = 0;
 
@@ -35,6 +38,7 @@ public:
 	virtual Bounds3f worldBound() const;
 	virtual bool hit(const Ray& ray) const override;
 	virtual bool hit(const Ray& ray, SurfaceInteraction& iset) const override;
+	virtual bool getTriangleVertices(Vector3f p[3]) const override;
 
 	virtual const AreaLight* getAreaLight() const override;
 	virtual const Material* getMaterial() const override;
@@ -48,9 +52,23 @@ private:
 	Material::ptr m_material;
 };
 
+//Note: largest packet accepted by HitableAggregate::hit(const Ray*, ...)
+constexpr int MaxRayPacketSize = 16;
+
 class HitableAggregate : public Hitable
 {
 public:
+	typedef std::shared_ptr<HitableAggregate> ptr;
+
+	using Hitable::hit;
+
+	// Closest hits for a packet of up to _MaxRayPacketSize_ coherent rays, returns the
+	// mask of rays that hit something. The default traces the rays one by one.
+	virtual uint32_t hit(const Ray* rays, int nRays, SurfaceInteraction* isects) const;
+	// Any-hit queries for a packet of up to _MaxRayPacketSize_ rays, returns the mask of
+	// rays that are blocked. The default tests the rays one by one.
+	virtual uint32_t occluded(const Ray* rays, int nRays) const;
+
 	virtual const AreaLight* getAreaLight() const override;
 	virtual const Material* getMaterial() const override;
 
@@ -58,6 +76,36 @@ public:
 		TransportMode mode, bool allowMultipleLobes) const override;
 };
 
+//Note: one placement of a shared aggregate (a bottom-level BVH built in object space).
+//      Only the transform is stored per instance, rays are moved into the instance space
+//      during traversal and the hit is moved back. The interaction keeps pointing at the
+//      hitable found inside the aggregate, which supplies the material.
+class HitableInstance final : public Hitable
+{
+public:
+	typedef std::shared_ptr<HitableInstance> ptr;
+
+	HitableInstance(const HitableAggregate::ptr& aggregate, const Transform& instanceToWorld);
+
+	virtual Bounds3f worldBound() const override { return m_worldBound; }
+	virtual bool hit(const Ray& ray) const override;
+	virtual bool hit(const Ray& ray, SurfaceInteraction& iset) const override;
+
+	virtual const AreaLight* getAreaLight() const override { return nullptr; }
+	virtual const Material* getMaterial() const override { return nullptr; }
+
+	virtual void computeScatteringFunctions(SurfaceInteraction& isect, MemoryArena& arena,
+		TransportMode mode, bool allowMultipleLobes) const override;
+
+private:
+	// Instance space ray, _scale_ maps world hit distances to instance ones
+	Ray toInstance(const Ray& ray, Float& scale) const;
+
+	HitableAggregate::ptr m_aggregate;
+	Transform m_instanceToWorld;
+	Bounds3f m_worldBound;
+};
+
 class HitableList final : public HitableAggregate
 {
 public:
@@ -95,10 +95,15 @@ Vector2f RandomSampler::get2D()
 std::unique_ptr<Sampler> RandomSampler::clone(int seed)
 {
 	RandomSampler* rs = new RandomSampler(*this);
-	rs->m_rng.setSequence(seed);
+	rs->reseed(seed);
 	return std::unique_ptr<Sampler>(rs);
 }
 
+void RandomSampler::reseed(int seed)
+{
+	m_rng.setSequence(seed);
+}
+
 void RandomSampler::startPixel(const Vector2i& p)
 {
 	for (size_t i = 0; i < m_sampleArray1D.size(); ++i)
@@ -112,6 +117,268 @@ void RandomSampler::startPixel(const Vector2i& p)
 	Sampler::startPixel(p);
 }
 
+static void extendedGCD(uint64_t a, uint64_t b, int64_t* x, int64_t* y)
+{
+	if (b == 0)
+	{
+		*x = 1;
+		*y = 0;
+		return;
+	}
+	int64_t d = a / b, xp, yp;
+	extendedGCD(b, a % b, &xp, &yp);
+	*x = yp;
+	*y = xp - (d * yp);
+}
+
+static uint64_t multiplicativeInverse(int64_t a, int64_t n)
+{
+	int64_t x, y;
+	extendedGCD(a, n, &x, &y);
+	return ((x % n) + n) % n;
+}
+
+HaltonSampler::HaltonSampler(int64_t samplesPerPixel, const Bounds2i& sampleBounds)
+	: Sampler(samplesPerPixel)
+{
+	// Find radical inverse base scales and exponents that cover sampling area
+	Vector2i res = sampleBounds.m_pMax - sampleBounds.m_pMin;
+	for (int i = 0; i < 2; ++i)
+	{
+		int base = (i == 0) ? 2 : 3;
+		int scale = 1, exp = 0;
+		while (scale < glm::min(res[i], MaxResolution))
+		{
+			scale *= base;
+			++exp;
+		}
+		m_baseScales[i] = scale;
+		m_baseExponents[i] = exp;
+	}
+
+	// Compute stride in samples for visiting each pixel area
+	m_sampleStride = m_baseScales[0] * m_baseScales[1];
+
+	// Compute multiplicative inverses for _baseScales_
+	m_multInverse[0] = (int)multiplicativeInverse(m_baseScales[1], m_baseScales[0]);
+	m_multInverse[1] = (int)multiplicativeInverse(m_baseScales[0], m_baseScales[1]);
+}
+
+const std::vector<uint16_t>& HaltonSampler::radicalInversePermutations()
+{
+	//Note: shared by all Halton samplers, the scrambling is part of the sequence
+	static const std::vector<uint16_t> perms = []()
+	{
+		Rng rng;
+		return computeRadicalInversePermutations(rng);
+	}();
+	return perms;
+}
+
+int64_t HaltonSampler::getIndexForSample(int64_t sampleNum)
+{
+	Vector2i pixel(m_currentPixel);
+	if (pixel != m_pixelForOffset)
+	{
+		// Compute Halton sample offset for _currentPixel_
+		m_offsetForCurrentPixel = 0;
+		if (m_sampleStride > 1)
+		{
+			//Note: sample bounds reach past the film by the filter radius, the coordinates may be negative
+			Vector2i pm(mod(pixel.x, MaxResolution), mod(pixel.y, MaxResolution));
+			for (int i = 0; i < 2; ++i)
+			{
+				uint64_t dimOffset = (i == 0) ?
+					inverseRadicalInverse<2>(pm[i], m_baseExponents[i]) :
+					inverseRadicalInverse<3>(pm[i], m_baseExponents[i]);
+				m_offsetForCurrentPixel += dimOffset * (m_sampleStride / m_baseScales[i]) * m_multInverse[i];
+			}
+			m_offsetForCurrentPixel %= m_sampleStride;
+		}
+		m_pixelForOffset = pixel;
+	}
+	return m_offsetForCurrentPixel + sampleNum * m_sampleStride;
+}
+
+Float HaltonSampler::sampleDimension(int64_t index, int dimension) const
+{
+	// The first two dimensions are the position inside the pixel
+	if (dimension == 0)
+		return radicalInverse(dimension, index >> m_baseExponents[0]);
+	else if (dimension == 1)
+		return radicalInverse(dimension, index / m_baseScales[1]);
+	else
+		return scrambledRadicalInverse(dimension, index, &radicalInversePermutations()[PrimeSums[dimension]]);
+}
 
+void HaltonSampler::startPixel(const Vector2i& p)
+{
+	Sampler::startPixel(p);
+	m_dimension = 0;
+	m_intervalSampleIndex = getIndexForSample(0);
+
+	// Compute _arrayEndDim_ for dimensions used for array samples
+	m_arrayEndDim = ArrayStartDim + (int)m_sampleArray1D.size() + 2 * (int)m_sampleArray2D.size();
+
+	// Compute 1D array samples for _HaltonSampler_
+	for (size_t i = 0; i < m_samples1DArraySizes.size(); ++i)
+	{
+		int64_t nSamples = m_samples1DArraySizes[i] * samplesPerPixel;
+		for (int64_t j = 0; j < nSamples; ++j)
+			m_sampleArray1D[i][j] = sampleDimension(getIndexForSample(j), ArrayStartDim + (int)i);
+	}
+
+	// Compute 2D array samples for _HaltonSampler_
+	int dim = ArrayStartDim + (int)m_samples1DArraySizes.size();
+	for (size_t i = 0; i < m_samples2DArraySizes.size(); ++i)
+	{
+		int64_t nSamples = m_samples2DArraySizes[i] * samplesPerPixel;
+		for (int64_t j = 0; j < nSamples; ++j)
+		{
+			int64_t index = getIndexForSample(j);
+			m_sampleArray2D[i][j] = Vector2f(sampleDimension(index, dim), sampleDimension(index, dim + 1));
+		}
+		dim += 2;
+	}
+	CHECK_EQ(m_arrayEndDim, dim);
+}
+
+bool HaltonSampler::startNextSample()
+{
+	m_dimension = 0;
+	m_intervalSampleIndex = getIndexForSample(m_currentPixelSampleIndex + 1);
+	return Sampler::startNextSample();
+}
+
+bool HaltonSampler::setSampleNumber(int64_t sampleNum)
+{
+	m_dimension = 0;
+	m_intervalSampleIndex = getIndexForSample(sampleNum);
+	return Sampler::setSampleNumber(sampleNum);
+}
+
+Float HaltonSampler::get1D()
+{
+	if (m_dimension >= ArrayStartDim && m_dimension < m_arrayEndDim)
+		m_dimension = m_arrayEndDim;
+	//Note: there is one scrambled base per prime in the table, deep paths wrap around
+	if (m_dimension >= PrimeTableSize)
+		m_dimension = 2;
+	return sampleDimension(m_intervalSampleIndex, m_dimension++);
+}
+
+Vector2f HaltonSampler::get2D()
+{
+	if (m_dimension + 1 >= ArrayStartDim && m_dimension < m_arrayEndDim)
+		m_dimension = m_arrayEndDim;
+	if (m_dimension + 1 >= PrimeTableSize)
+		m_dimension = 2;
+	Vector2f p(sampleDimension(m_intervalSampleIndex, m_dimension),
+		sampleDimension(m_intervalSampleIndex, m_dimension + 1));
+	m_dimension += 2;
+	return p;
+}
+
+std::unique_ptr<Sampler> HaltonSampler::clone(int seed)
+{
+	return std::unique_ptr<Sampler>(new HaltonSampler(*this));
+}
+
+// Finalizer of MurmurHash3, spreads every input bit over the whole word
+static uint64_t mixBits(uint64_t v)
+{
+	v ^= (v >> 31);
+	v *= 0x7fb5d329728ea185ull;
+	v ^= (v >> 27);
+	v *= 0x81dadef4bc2dd44dull;
+	v ^= (v >> 33);
+	return v;
+}
+
+static int roundUpPow2(int v)
+{
+	v--;
+	v |= v >> 1;
+	v |= v >> 2;
+	v |= v >> 4;
+	v |= v >> 8;
+	v |= v >> 16;
+	return v + 1;
+}
+
+//Note: hash salts that keep the dimensions of the sample arrays apart from get1D()/get2D()
+static const uint64_t SobolArray1DSalt = 0x100000000ull;
+static const uint64_t SobolArray2DSalt = 0x200000000ull;
+
+SobolSampler::SobolSampler(int64_t samplesPerPixel, uint32_t seed)
+	: Sampler(samplesPerPixel), m_seed(seed)
+{
+
+}
+
+int SobolSampler::roundCount(int n) const
+{
+	return roundUpPow2(n);
+}
+
+Vector2f SobolSampler::sample2D(uint64_t index, uint64_t dimensionHash) const
+{
+	uint64_t hash = mixBits(m_pixelHash ^ dimensionHash);
+
+	//Note: shuffling the index by a nested uniform scramble maps every aligned power of two
+	//      block of indices to another one, prefixes of the sequence stay stratified.
+	uint32_t shuffled = nestedUniformScramble((uint32_t)index, (uint32_t)hash);
+	uint32_t x = nestedUniformScramble(sobolSample2(shuffled, 0), (uint32_t)(hash >> 32));
+	uint32_t y = nestedUniformScramble(sobolSample2(shuffled, 1), (uint32_t)mixBits(hash));
+	return Vector2f(bitsToUnitFloat(x), bitsToUnitFloat(y));
+}
+
+void SobolSampler::startPixel(const Vector2i& p)
+{
+	Sampler::startPixel(p);
+	m_dimension = 0;
+	m_pixelHash = mixBits(((uint64_t)(uint32_t)p.x << 32) ^ (uint64_t)(uint32_t)p.y ^ ((uint64_t)m_seed << 16));
+
+	// Every array is one (0,2)-sequence, sample _j_ owns its _j_-th block of _n_ points
+	for (size_t i = 0; i < m_samples1DArraySizes.size(); ++i)
+	{
+		for (size_t j = 0; j < m_sampleArray1D[i].size(); ++j)
+			m_sampleArray1D[i][j] = sample2D(j, SobolArray1DSalt + i).x;
+	}
+	for (size_t i = 0; i < m_samples2DArraySizes.size(); ++i)
+	{
+		for (size_t j = 0; j < m_sampleArray2D[i].size(); ++j)
+			m_sampleArray2D[i][j] = sample2D(j, SobolArray2DSalt + i);
+	}
+}
+
+bool SobolSampler::startNextSample()
+{
+	m_dimension = 0;
+	return Sampler::startNextSample();
+}
+
+bool SobolSampler::setSampleNumber(int64_t sampleNum)
+{
+	m_dimension = 0;
+	return Sampler::setSampleNumber(sampleNum);
+}
+
+Float SobolSampler::get1D()
+{
+	CHECK_LT(m_currentPixelSampleIndex, samplesPerPixel);
+	return sample2D(m_currentPixelSampleIndex, m_dimension++).x;
+}
+
+Vector2f SobolSampler::get2D()
+{
+	CHECK_LT(m_currentPixelSampleIndex, samplesPerPixel);
+	return sample2D(m_currentPixelSampleIndex, m_dimension++);
+}
+
+std::unique_ptr<Sampler> SobolSampler::clone(int seed)
+{
+	return std::unique_ptr<Sampler>(new SobolSampler(*this));
+}
 
 RENDER_END
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include "../Math/KMathUtil.h"
 
 #include "../Math/Rng.h"
+#include "../Math/LowDiscrepancy.h"
 
 #include <vector>
 
@@ -33,6 +34,9 @@ public:
 	virtual bool startNextSample();
 
 	virtual std::unique_ptr<Sampler> clone(int seed) = 0;
+	//Note: puts a clone of the same sampler into the state clone(_seed_) would create it in,
+	//      lets per-worker samplers be reused across tiles instead of cloned for each one.
+	virtual void reseed(int seed) = 0;
 	virtual bool setSampleNumber(int64_t sampleNum);
 
 	int64_t currentSampleNumber() const { return m_currentPixelSampleIndex; }
@@ -65,9 +69,88 @@ public:
 	virtual Vector2f get2D() override;
 
 	virtual std::unique_ptr<Sampler> clone(int seed) override;
+	virtual void reseed(int seed) override;
 
 private:	
 	Rng m_rng;
 };
 
+//Note: the samplers below compute their samples from the pixel and the sample index alone,
+//      any thread and any tile order reproduce the same image and progressive passes extend
+//      the sequence of a pixel instead of starting a new one. _seed_ of clone()/reseed()
+//      is ignored for that reason.
+
+// Halton sequence over the whole image, the samples of a pixel are found by inverting the
+// radical inverses of the first two dimensions. Dimensions from the third on are scrambled
+// with random digit permutations.
+class HaltonSampler : public Sampler
+{
+public:
+	typedef std::shared_ptr<HaltonSampler> ptr;
+
+	HaltonSampler(int64_t samplesPerPixel, const Bounds2i& sampleBounds);
+
+	virtual void startPixel(const Vector2i& p) override;
+	virtual bool startNextSample() override;
+	virtual bool setSampleNumber(int64_t sampleNum) override;
+
+	virtual Float get1D() override;
+	virtual Vector2f get2D() override;
+
+	virtual std::unique_ptr<Sampler> clone(int seed) override;
+	virtual void reseed(int seed) override {}
+
+private:
+	int64_t getIndexForSample(int64_t sampleNum);
+	Float sampleDimension(int64_t index, int dimension) const;
+
+	static const std::vector<uint16_t>& radicalInversePermutations();
+
+	//Note: the first two dimensions repeat every _m_baseScales_ pixels
+	static CONSTEXPR int MaxResolution = 128;
+	//Note: dimensions [ArrayStartDim, m_arrayEndDim) are taken by the sample arrays
+	static CONSTEXPR int ArrayStartDim = 5;
+
+	Vector2i m_baseScales, m_baseExponents;
+	int m_sampleStride;
+	int m_multInverse[2];
+
+	Vector2i m_pixelForOffset = Vector2i(std::numeric_limits<int>::max());
+	int64_t m_offsetForCurrentPixel = 0;
+
+	int64_t m_intervalSampleIndex = 0;
+	int m_dimension = 0;
+	int m_arrayEndDim = ArrayStartDim;
+};
+
+// Padded 2D Sobol' (0,2)-sequences, every pair of dimensions draws from its own Owen scrambled
+// copy and the sample indices are shuffled per pair so that the pairs do not correlate.
+class SobolSampler : public Sampler
+{
+public:
+	typedef std::shared_ptr<SobolSampler> ptr;
+
+	SobolSampler(int64_t samplesPerPixel, uint32_t seed = 0);
+
+	//Note: sample arrays are powers of two, each one then is a stratified block of the sequence
+	virtual int roundCount(int n) const override;
+
+	virtual void startPixel(const Vector2i& p) override;
+	virtual bool startNextSample() override;
+	virtual bool setSampleNumber(int64_t sampleNum) override;
+
+	virtual Float get1D() override;
+	virtual Vector2f get2D() override;
+
+	virtual std::unique_ptr<Sampler> clone(int seed) override;
+	virtual void reseed(int seed) override {}
+
+private:
+	Vector2f sample2D(uint64_t index, uint64_t dimensionHash) const;
+
+	const uint32_t m_seed;
+	uint64_t m_pixelHash = 0;
+	int m_dimension = 0;
+};
+
 RENDER_END
\ No newline at end of file
@@ -1,17 +1,58 @@
 #include "Scene.h"
+#include "../Tool/Parallel.h"
 
 RENDER_BEGIN
 
 bool Scene::hit(const Ray& ray) const
 {
+	++m_rayCount.local();
 	return m_aggreShape->hit(ray);
 }
 
 bool Scene::hit(const Ray& ray, SurfaceInteraction& isect) const
 {
+	++m_rayCount.local();
 	return m_aggreShape->hit(ray, isect);
 }
 
+uint32_t Scene::hit(const Ray* rays, int nRays, SurfaceInteraction* isects) const
+{
+	m_rayCount.local() += nRays;
+	return m_aggreShape->hit(rays, nRays, isects);
+}
+
+void Scene::occluded(const Ray* rays, size_t nRays, RayBitset& occluded) const
+{
+	occluded.reset(nRays);
+
+	// Every task fills whole words of the bitset
+	parallelFor((size_t)0, occluded.wordCount(), (size_t)4, [&](const tbb::blocked_range<size_t>& range)
+		{
+			int64_t nTraced = 0;
+			for (size_t w = range.begin(); w != range.end(); ++w)
+			{
+				size_t end = glm::min(64 * w + 64, nRays);
+				uint64_t word = 0;
+				for (size_t start = 64 * w; start < end; start += MaxRayPacketSize)
+				{
+					int nPacket = (int)glm::min(end - start, (size_t)MaxRayPacketSize);
+					word |= (uint64_t)m_aggreShape->occluded(rays + start, nPacket) << (start - 64 * w);
+					nTraced += nPacket;
+				}
+				occluded.word(w) = word;
+			}
+			m_rayCount.local() += nTraced;
+		});
+}
+
+int64_t Scene::getRayCount() const
+{
+	int64_t count = 0;
+	for (int64_t local : m_rayCount)
+		count += local;
+	return count;
+}
+
 bool Scene::hitTr(Ray ray, Sampler& sampler, SurfaceInteraction& isect, Spectrum& Tr) const
 {
 	Tr = Spectrum(1.f);
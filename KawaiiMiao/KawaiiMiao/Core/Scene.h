@@ -5,15 +5,31 @@
 #include "Primitive.h"
 #include "../Math/KMathUtil.h"
 
+#include <tbb/tbb/enumerable_thread_specific.h>
+
 RENDER_BEGIN
 
+//Note: one bit per ray of a batched query
+class RayBitset
+{
+public:
+	void reset(size_t nRays) { m_words.assign((nRays + 63) / 64, 0); }
+	bool operator[](size_t i) const { return (m_words[i / 64] >> (i % 64)) & 1; }
+
+	size_t wordCount() const { return m_words.size(); }
+	uint64_t& word(size_t w) { return m_words[w]; }
+
+private:
+	std::vector<uint64_t> m_words;
+};
+
 class Scene
 {
 public:
 	typedef std::shared_ptr<Scene> ptr;
 
 	Scene(const HitableAggregate::ptr& hitables, const std::vector<Light::ptr>& lights)
-		: m_lights(lights), m_aggreShape(hitables)
+		: m_lights(lights), m_worldBound(hitables->worldBound()), m_aggreShape(hitables)
 	{
 		for (const auto& light : lights)
 		{
@@ -27,8 +43,18 @@ public:
 
 	bool hit(const Ray& ray) const;
 	bool hit(const Ray& ray, SurfaceInteraction& isect) const;
+	// Closest hits of a packet of coherent rays, returns the mask of rays that hit
+	uint32_t hit(const Ray* rays, int nRays, SurfaceInteraction* isects) const;
+	//Note: any-hit queries for a batch of rays, e.g. all the shadow rays of a tile or a
+	//      wavefront. Bit i of _occluded_ is set if something blocks ray i. The rays are
+	//      traced as packets in their batch order, neighbours should be coherent.
+	void occluded(const Ray* rays, size_t nRays, RayBitset& occluded) const;
 	bool hitTr(Ray ray, Sampler& sampler, SurfaceInteraction& isect, Spectrum& transmittance) const;
 
+	//Note: number of rays traced against the aggregate, used to report rays/s
+	int64_t getRayCount() const;
+	void resetRayCount() const { m_rayCount.clear(); }
+
 	std::vector<Light::ptr> m_lights;
 	// Store infinite light sources separately for cases where we only want
 	// to loop over them.
@@ -38,6 +64,11 @@ private:
 	// Scene Private Data
 	Bounds3f m_worldBound;
 	HitableAggregate::ptr m_aggreShape;
+
+	//Note: per-thread counters, the hot path never touches a shared cache line
+	using RayCounter = tbb::enumerable_thread_specific<int64_t,
+		tbb::cache_aligned_allocator<int64_t>, tbb::ets_key_per_instance>;
+	mutable RayCounter m_rayCount;
 };
 
 RENDER_END
\ No newline at end of file
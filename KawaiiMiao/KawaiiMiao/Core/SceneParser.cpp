@@ -1,10 +1,521 @@
 #include "SceneParser.h"
 
+#include "BVH.h"
+#include "Shape.h"
+#include "Light.h"
+#include "Filter.h"
+#include "MeshLoader.h"
+#include "PathIntegrator.h"
+#include "WavefrontIntegrator.h"
+
+#include <chrono>
+#include <fstream>
+#include <tbb/tbb/parallel_for.h>
+
 RENDER_BEGIN
 
-void SceneParser::parser(const std::string& path)
+//Note: wall clock time of one phase of the scene setup, in milliseconds
+class PhaseTimer
+{
+public:
+	PhaseTimer() : m_start(std::chrono::system_clock::now()) {}
+
+	Float lap()
+	{
+		auto now = std::chrono::system_clock::now();
+		Float elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - m_start).count();
+		m_start = now;
+		return elapsed;
+	}
+
+private:
+	std::chrono::system_clock::time_point m_start;
+};
+
+bool SceneParser::parser(const std::string& path, ParsedScene& parsed)
+{
+	PhaseTimer timer;
+
+	std::ifstream file(path);
+	if (!file)
+	{
+		K_ERROR(stringPrintf("Failed to open scene file %s", path.c_str()));
+		return false;
+	}
+
+	//Note: relative asset paths are relative to the scene file.
+	std::string directory;
+	size_t slash = path.find_last_of("/\\");
+	if (slash != std::string::npos)
+		directory = path.substr(0, slash + 1);
+
+	try
+	{
+		json_value root = nlohmann::json::parse(file);
+		auto section = [&root](const char* name) -> json_value
+		{
+			return root.contains(name) ? root[name] : json_value::object();
+		};
+
+		//-------------------------------------------Parsing-------------------------------------
+
+		Film::ptr film = parseFilm(root.at("film"));
+		Sampler::ptr sampler = parseSampler(section("sampler"), film);
+		Camera::ptr camera = parseCamera(root.at("camera"), film);
+		if (film == nullptr || sampler == nullptr || camera == nullptr)
+			return false;
+
+		Vector2i res = film->getResolution();
+		SamplerIntegrator::ptr integrator = parseIntegrator(section("integrator"), camera, sampler,
+			Bounds2i(Vector2i(0, 0), res));
+		if (integrator == nullptr)
+			return false;
+
+		std::map<std::string, Material::ptr> materials;
+		if (!parseMaterials(section("materials"), materials))
+			return false;
+
+		// Analytic shapes are created right away, meshes are only collected
+		std::vector<Hitable::ptr> hitables;
+		std::vector<MeshEntry> meshEntries;
+		for (const auto& shape : root["shapes"])
+		{
+			Material::ptr material;
+			if (!findMaterial(shape, materials, material))
+				return false;
+			Transform objectToWorld = parseTransform(shape.value("transform", json_value()));
+			std::string type = shape.value("type", "");
+			if (type == "mesh")
+			{
+				std::string filename = shape.at("filename").get<std::string>();
+				if (!filename.empty() && filename[0] != '/' && filename.find(':') == std::string::npos)
+					filename = directory + filename;
+
+				//Note: "instances" places the mesh once per listed transform, each applied
+				//      after the shape's own "transform".
+				if (shape.contains("instances"))
+				{
+					for (const auto& instance : shape["instances"])
+						meshEntries.push_back({ filename, parseTransform(instance) * objectToWorld, material });
+				}
+				else
+				{
+					meshEntries.push_back({ filename, objectToWorld, material });
+				}
+				continue;
+			}
+
+			Shape::ptr s = parseShape(shape, objectToWorld);
+			if (s == nullptr)
+				return false;
+			hitables.push_back(std::make_shared<HitableEntity>(s, material, nullptr));
+		}
+
+		//Note: only diffuse area lights exist, their shape is added to the scene as well.
+		std::vector<Light::ptr> lights;
+		for (const auto& light : root["lights"])
+		{
+			std::string type = light.value("type", "area");
+			if (type != "area")
+			{
+				K_ERROR(stringPrintf("Unknown light type %s", type.c_str()));
+				return false;
+			}
+
+			Transform lightToWorld = parseTransform(light.value("transform", json_value()));
+			Shape::ptr shape = parseShape(light.at("shape"), lightToWorld);
+			if (shape == nullptr)
+				return false;
+			AreaLight::ptr areaLight = std::make_shared<DiffuseAreaLight>(lightToWorld,
+				parseSpectrum(light.at("L")), light.value("nSamples", 1), shape, light.value("twoSided", false));
+			Material::ptr material;
+			if (!findMaterial(light, materials, material))
+				return false;
+			hitables.push_back(std::make_shared<HitableEntity>(shape, material, areaLight));
+			lights.push_back(areaLight);
+		}
+
+		Float parseTime = timer.lap();
+
+		//-------------------------------------------Asset loading-------------------------------------
+
+		// Every file is imported once, however often it is placed
+		std::vector<std::string> filenames;
+		std::map<std::string, int> fileIndices;
+		for (const MeshEntry& entry : meshEntries)
+		{
+			if (fileIndices.emplace(entry.filename, (int)filenames.size()).second)
+				filenames.push_back(entry.filename);
+		}
+
+		// Independent files are imported concurrently on the TBB pool
+		std::vector<std::vector<MeshData>> meshData(filenames.size());
+		tbb::parallel_for(size_t(0), filenames.size(), [&](size_t i)
+		{
+			meshData[i] = MeshLoader::load(filenames[i]);
+		});
+
+		for (size_t i = 0; i < filenames.size(); ++i)
+		{
+			if (meshData[i].empty())
+			{
+				K_ERROR(stringPrintf("Failed to load mesh %s", filenames[i].c_str()));
+				return false;
+			}
+		}
+
+		//Note: a mesh placed more than once with the same material gets one bottom-level BVH
+		//      in object space that all of its placements share, a mesh placed once is baked
+		//      into world space and goes straight into the top-level BVH.
+		const json_value accel = section("accelerator");
+		bool instancing = accel.value("instancing", true);
+		std::map<std::pair<std::string, const Material*>, std::vector<int>> placements;
+		for (int i = 0; i < (int)meshEntries.size(); ++i)
+			placements[{ meshEntries[i].filename, meshEntries[i].material.get() }].push_back(i);
+
+		std::vector<const std::vector<int>*> shared;
+		std::vector<char> isShared(meshEntries.size(), 0);
+		for (const auto& placement : placements)
+		{
+			if (!instancing || placement.second.size() < 2)
+				continue;
+			shared.push_back(&placement.second);
+			for (int i : placement.second)
+				isShared[i] = 1;
+		}
+
+		std::vector<std::vector<TriangleMesh::ptr>> bakedMeshes(meshEntries.size());
+		tbb::parallel_for(size_t(0), meshEntries.size(), [&](size_t i)
+		{
+			if (isShared[i])
+				return;
+			const MeshEntry& entry = meshEntries[i];
+			bakedMeshes[i] = MeshLoader::createMeshes(meshData[fileIndices.at(entry.filename)],
+				entry.objectToWorld, entry.material);
+		});
+
+		std::vector<TriangleMesh::ptr> meshes;
+		for (const auto& baked : bakedMeshes)
+			meshes.insert(meshes.end(), baked.begin(), baked.end());
+
+		Float assetTime = timer.lap();
+
+		//-------------------------------------------Acceleration build-------------------------------------
+
+		int maxHitablesInNode = accel.value("maxHitablesInNode", 4);
+		std::string layoutName = accel.value("layout", "bvh2");
+		BVHLayout layout = BVHLayout::Binary;
+		if (layoutName == "bvh4")
+			layout = BVHLayout::BVH4;
+		else if (layoutName == "bvh8")
+			layout = BVHLayout::BVH8;
+		else if (layoutName == "qbvh4")
+			layout = BVHLayout::QuantizedBVH4;
+		else if (layoutName == "qbvh8")
+			layout = BVHLayout::QuantizedBVH8;
+		else if (layoutName != "bvh2")
+		{
+			K_ERROR(stringPrintf("Unknown BVH layout %s", layoutName.c_str()));
+			return false;
+		}
+
+		std::vector<HitableBVH::ptr> blas(shared.size());
+		tbb::parallel_for(size_t(0), shared.size(), [&](size_t i)
+		{
+			const MeshEntry& entry = meshEntries[shared[i]->front()];
+			std::vector<TriangleMesh::ptr> objectMeshes = MeshLoader::createMeshes(
+				meshData[fileIndices.at(entry.filename)], Transform(Matrix4x4(1.0f)), entry.material);
+			blas[i] = std::make_shared<HitableBVH>(std::vector<Hitable::ptr>(), objectMeshes,
+				maxHitablesInNode, layout);
+		});
+
+		int nInstances = 0;
+		for (size_t i = 0; i < shared.size(); ++i)
+		{
+			for (int entry : *shared[i])
+				hitables.push_back(std::make_shared<HitableInstance>(blas[i], meshEntries[entry].objectToWorld));
+			nInstances += (int)shared[i]->size();
+		}
+
+		HitableBVH::ptr aggregate = std::make_shared<HitableBVH>(std::move(hitables), meshes,
+			maxHitablesInNode, layout);
+		parsed.scene = std::make_shared<Scene>(aggregate, lights);
+		parsed.integrator = integrator;
+		parsed.sampler = sampler;
+
+		Float buildTime = timer.lap();
+		K_INFO(stringPrintf("Scene %s: parsing %.0f ms, asset loading %.0f ms (%d meshes), "
+			"acceleration build %.0f ms", path.c_str(), parseTime, assetTime, (int)meshes.size(), buildTime));
+		if (!shared.empty())
+		{
+			K_INFO(stringPrintf("Instancing: %d instances of %d shared bottom-level BVHs",
+				nInstances, (int)shared.size()));
+		}
+	}
+	catch (const nlohmann::json::exception& e)
+	{
+		K_ERROR(stringPrintf("Failed to parse scene file %s: %s", path.c_str(), e.what()));
+		return false;
+	}
+
+	return true;
+}
+
+Vector3f SceneParser::parseVector3f(const json_value& value)
+{
+	return Vector3f(value.at(0).get<Float>(), value.at(1).get<Float>(), value.at(2).get<Float>());
+}
+
+Spectrum SceneParser::parseSpectrum(const json_value& value)
+{
+	if (value.is_number())
+		return Spectrum(value.get<Float>());
+
+	Float rgb[3] = { value.at(0).get<Float>(), value.at(1).get<Float>(), value.at(2).get<Float>() };
+	return Spectrum::fromRGB(rgb);
+}
+
+Transform SceneParser::parseTransform(const json_value& value)
+{
+	//Note: a list of operations, the first one listed is applied first.
+	Transform objectToWorld(Matrix4x4(1.0f));
+	if (value.is_null())
+		return objectToWorld;
+
+	for (const auto& op : value)
+	{
+		Transform t(Matrix4x4(1.0f));
+		if (op.contains("translate"))
+			t = translate(parseVector3f(op["translate"]));
+		else if (op.contains("scale"))
+		{
+			const json_value& s = op["scale"];
+			t = s.is_number() ? scale(s.get<Float>(), s.get<Float>(), s.get<Float>())
+				: scale(s.at(0).get<Float>(), s.at(1).get<Float>(), s.at(2).get<Float>());
+		}
+		else if (op.contains("rotate"))
+		{
+			// [angle in degrees, axis x, axis y, axis z]
+			const json_value& r = op["rotate"];
+			t = rotate(r.at(0).get<Float>(), Vector3f(r.at(1).get<Float>(), r.at(2).get<Float>(), r.at(3).get<Float>()));
+		}
+		else if (op.contains("matrix"))
+		{
+			// Row major 4x4 matrix
+			const json_value& m = op["matrix"];
+			Float mat[4][4];
+			for (int i = 0; i < 4; ++i)
+				for (int j = 0; j < 4; ++j)
+					mat[i][j] = m.at(4 * i + j).get<Float>();
+			t = Transform(mat);
+		}
+		else
+			K_ERROR("Ignoring unknown transform operation " + op.dump());
+		objectToWorld = t * objectToWorld;
+	}
+	return objectToWorld;
+}
+
+bool SceneParser::parseMaterials(const json_value& value, std::map<std::string, Material::ptr>& materials)
 {
+	for (auto it = value.begin(); it != value.end(); ++it)
+	{
+		const json_value& material = it.value();
+		std::string type = material.value("type", "");
+		Spectrum R = material.contains("R") ? parseSpectrum(material["R"]) : Spectrum(1.f);
+		if (type == "lambertian")
+			materials[it.key()] = std::make_shared<LambertianMaterial>(R);
+		else if (type == "mirror")
+			materials[it.key()] = std::make_shared<MirrorMaterial>(R);
+		else
+		{
+			K_ERROR(stringPrintf("Unknown material type %s for %s", type.c_str(), it.key().c_str()));
+			return false;
+		}
+	}
+	return true;
+}
+
+bool SceneParser::findMaterial(const json_value& value, const std::map<std::string, Material::ptr>& materials,
+	Material::ptr& material)
+{
+	//Note: a hitable without material only bounds the scene, it never scatters light.
+	material = nullptr;
+	if (!value.contains("material"))
+		return true;
+
+	std::string name = value["material"].get<std::string>();
+	auto it = materials.find(name);
+	if (it == materials.end())
+	{
+		K_ERROR(stringPrintf("Unknown material %s", name.c_str()));
+		return false;
+	}
+	material = it->second;
+	return true;
+}
+
+Shape::ptr SceneParser::parseShape(const json_value& value, const Transform& objectToWorld)
+{
+	std::string type = value.value("type", "");
+	if (type == "sphere")
+	{
+		return std::make_shared<SphereShape>(objectToWorld, inverse(objectToWorld),
+			value.value("radius", 1.0f));
+	}
+	else if (type == "triangle")
+	{
+		const json_value& vertices = value.at("vertices");
+		Vector3f v[3] = { parseVector3f(vertices.at(0)), parseVector3f(vertices.at(1)), parseVector3f(vertices.at(2)) };
+		return std::make_shared<TriangleShape>(objectToWorld, inverse(objectToWorld), v);
+	}
+
+	K_ERROR(stringPrintf("Unknown shape type %s", type.c_str()));
+	return nullptr;
+}
+
+Film::ptr SceneParser::parseFilm(const json_value& value)
+{
+	const json_value& resolution = value.at("resolution");
+	Vector2i res(resolution.at(0).get<int>(), resolution.at(1).get<int>());
+
+	std::unique_ptr<Filter> filter;
+	const json_value filterValue = value.value("filter", json_value::object());
+	std::string type = filterValue.value("type", "gaussian");
+	Vector2f radius(2.0f, 2.0f);
+	if (filterValue.contains("radius"))
+		radius = Vector2f(filterValue["radius"].at(0).get<Float>(), filterValue["radius"].at(1).get<Float>());
+	if (type == "gaussian")
+		filter.reset(new GaussianFilter(radius, filterValue.value("alpha", 2.0f)));
+	else if (type == "box")
+		filter.reset(new BoxFilter(radius));
+	else
+	{
+		K_ERROR(stringPrintf("Unknown filter type %s", type.c_str()));
+		return nullptr;
+	}
+
+	return std::make_shared<Film>(res, Bounds2f(Vector2f(0, 0), Vector2f(1, 1)),
+		std::move(filter), value.value("filename", "result.png"));
+}
+
+Sampler::ptr SceneParser::parseSampler(const json_value& value, const Film::ptr& film)
+{
+	if (film == nullptr)
+		return nullptr;
+
+	std::string type = value.value("type", "random");
+	int spp = value.value("spp", 8);
+	if (type == "random")
+		return std::make_shared<RandomSampler>(spp);
+	else if (type == "halton")
+		return std::make_shared<HaltonSampler>(spp, film->getSampleBounds());
+	else if (type == "sobol")
+		return std::make_shared<SobolSampler>(spp, value.value("seed", 0));
+
+	K_ERROR(stringPrintf("Unknown sampler type %s", type.c_str()));
+	return nullptr;
+}
+
+Camera::ptr SceneParser::parseCamera(const json_value& value, const Film::ptr& film)
+{
+	if (film == nullptr)
+		return nullptr;
+
+	std::string type = value.value("type", "perspective");
+	if (type != "perspective")
+	{
+		K_ERROR(stringPrintf("Unknown camera type %s", type.c_str()));
+		return nullptr;
+	}
+
+	// Screen window keeps the aspect ratio of the film
+	Vector2i res = film->getResolution();
+	Bounds2f screen;
+	Float frame = (Float)(res.x) / res.y;
+	if (frame > 1.f)
+	{
+		screen.m_pMin.x = -frame;
+		screen.m_pMax.x = frame;
+		screen.m_pMin.y = -1.f;
+		screen.m_pMax.y = 1.f;
+	}
+	else
+	{
+		screen.m_pMin.x = -1.f;
+		screen.m_pMax.x = 1.f;
+		screen.m_pMin.y = -1.f / frame;
+		screen.m_pMax.y = 1.f / frame;
+	}
+
+	Vector3f eye = parseVector3f(value.at("eye"));
+	Vector3f center = parseVector3f(value.at("center"));
+	Vector3f up = value.contains("up") ? parseVector3f(value["up"]) : Vector3f(0, 1, 0);
+	auto cameraToWorld = inverse(lookAt(eye, center, up));
+	return std::make_shared<PerspectiveCamera>(cameraToWorld, screen, value.value("fovy", 45.0f), film);
+}
+
+SamplerIntegrator::ptr SceneParser::parseIntegrator(const json_value& value, const Camera::ptr& camera,
+	const Sampler::ptr& sampler, const Bounds2i& pixelBounds)
+{
+	std::string type = value.value("type", "whitted");
+	int maxDepth = value.value("maxDepth", 4);
+
+	SamplerIntegrator::ptr integrator;
+	if (type == "whitted")
+		integrator = std::make_shared<WhittedIntegrator>(maxDepth, camera, sampler, pixelBounds);
+	else if (type == "path")
+	{
+		integrator = std::make_shared<PathIntegrator>(maxDepth, camera, sampler, pixelBounds,
+			value.value("rrThreshold", 1.0f));
+	}
+	else if (type == "wavefront")
+	{
+		integrator = std::make_shared<WavefrontPathIntegrator>(maxDepth, camera, sampler, pixelBounds,
+			value.value("rrThreshold", 1.0f), value.value("waveSize", 1 << 16));
+		if (value.contains("adaptive") || value.contains("progressive") || value.contains("checkpoint"))
+			K_WARN("The wavefront integrator ignores the adaptive, progressive and checkpoint settings");
+	}
+	else
+	{
+		K_ERROR(stringPrintf("Unknown integrator type %s", type.c_str()));
+		return nullptr;
+	}
+
+	integrator->setRayPacketSize(value.value("rayPacketSize", 1));
 
+	std::string tileOrder = value.value("tileOrder", "hilbert");
+	TileOrder order = TileOrder::Hilbert;
+	if (tileOrder == "rowMajor")
+		order = TileOrder::RowMajor;
+	else if (tileOrder == "morton")
+		order = TileOrder::Morton;
+	else if (tileOrder == "spiral")
+		order = TileOrder::Spiral;
+	else if (tileOrder != "hilbert")
+		K_WARN(stringPrintf("Unknown tile order %s, falling back to hilbert", tileOrder.c_str()));
+	integrator->setTiling(order, value.value("tileSize", 16));
+	if (value.contains("adaptive"))
+	{
+		// The sampler's spp is the upper bound of the adaptive sample count
+		const json_value& adaptive = value["adaptive"];
+		integrator->setAdaptiveSampling(adaptive.value("minSpp", 4), adaptive.value("maxError", 0.05f),
+			adaptive.value("sampleMap", ""));
+	}
+	if (value.contains("progressive"))
+	{
+		const json_value& progressive = value["progressive"];
+		integrator->setProgressive(progressive.value("timeBudget", 0.0f),
+			progressive.value("snapshotInterval", 0.0f), progressive.value("snapshot", ""));
+	}
+	if (value.contains("checkpoint"))
+	{
+		// Rerunning the same scene file picks up an interrupted render by default
+		const json_value& checkpoint = value["checkpoint"];
+		integrator->setCheckpoint(checkpoint.value("filename", ""), checkpoint.value("interval", 0.0f),
+			checkpoint.value("resume", true));
+	}
+	return integrator;
 }
 
 RENDER_END
\ No newline at end of file
@@ -1,18 +1,59 @@
 #pragma once
 
 #include "Rendering.h"
+#include "Scene.h"
+#include "Shape.h"
+#include "Material.h"
+#include "Integrator.h"
+#include "../Math/KMathUtil.h"
+#include "../Math/Transform.h"
 
 #include <json/json.hpp>
 
+#include <map>
+#include <string>
+
 RENDER_BEGIN
 
+//Note: everything needed to render a scene file, the integrator already holds the
+//      camera, the film and the sampler.
+struct ParsedScene
+{
+	Scene::ptr scene;
+	SamplerIntegrator::ptr integrator;
+	Sampler::ptr sampler;
+};
+
+//Note: json scene description, see example/cornellBox.json for an example. Relative mesh
+//      paths are resolved against the directory of the scene file.
 class SceneParser
 {
 public:
-	static void parser(const std::string& path);
+	static bool parser(const std::string& path, ParsedScene& parsed);
 
 private:
 	using json_value = nlohmann::basic_json<>::value_type;
+
+	struct MeshEntry
+	{
+		std::string filename;
+		Transform objectToWorld;
+		Material::ptr material;
+	};
+
+	static Vector3f parseVector3f(const json_value& value);
+	static Spectrum parseSpectrum(const json_value& value);
+	static Transform parseTransform(const json_value& value);
+
+	static bool parseMaterials(const json_value& value, std::map<std::string, Material::ptr>& materials);
+	static Shape::ptr parseShape(const json_value& value, const Transform& objectToWorld);
+	static bool findMaterial(const json_value& value, const std::map<std::string, Material::ptr>& materials,
+		Material::ptr& material);
+	static Camera::ptr parseCamera(const json_value& value, const Film::ptr& film);
+	static Film::ptr parseFilm(const json_value& value);
+	static Sampler::ptr parseSampler(const json_value& value, const Film::ptr& film);
+	static SamplerIntegrator::ptr parseIntegrator(const json_value& value, const Camera::ptr& camera,
+		const Sampler::ptr& sampler, const Bounds2i& pixelBounds);
 };
 
 RENDER_END
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include "Interaction.h"
 #include "Sampling.h"
 #include <array>
+#include <immintrin.h>
 
 RENDER_BEGIN
 
@@ -347,117 +348,73 @@ Interaction TriangleShape::sample(const Vector2f& u, Float& pdf) const
 
 bool TriangleShape::hit(const Ray& ray) const
 {
-	// Get triangle vertices in _p0_, _p1_, and _p2_
-	const Vector3f& p0 = m_p0;
-	const Vector3f& p1 = m_p1;
-	const Vector3f& p2 = m_p2;
-
-	// Perform ray--triangle intersection test
-
-	// Transform triangle vertices to ray coordinate space
-
-	// Translate vertices based on ray origin
-	Vector3f p0t = p0 - Vector3f(ray.origin());
-	Vector3f p1t = p1 - Vector3f(ray.origin());
-	Vector3f p2t = p2 - Vector3f(ray.origin());
-
-	// Permute components of triangle vertices and ray direction
-	int kz = maxDimension(abs(ray.direction()));
-	int kx = kz + 1;
-	if (kx == 3) kx = 0;
-	int ky = kx + 1;
-	if (ky == 3) ky = 0;
-	Vector3f d = permute(ray.direction(), kx, ky, kz);
-	p0t = permute(p0t, kx, ky, kz);
-	p1t = permute(p1t, kx, ky, kz);
-	p2t = permute(p2t, kx, ky, kz);
-
-	// Apply shear transformation to translated vertex positions
-	Float Sx = -d.x / d.z;
-	Float Sy = -d.y / d.z;
-	Float Sz = 1.f / d.z;
-	p0t.x += Sx * p0t.z;
-	p0t.y += Sy * p0t.z;
-	p1t.x += Sx * p1t.z;
-	p1t.y += Sy * p1t.z;
-	p2t.x += Sx * p2t.z;
-	p2t.y += Sy * p2t.z;
-
-	// Compute edge function coefficients _e0_, _e1_, and _e2_
-	Float e0 = p1t.x * p2t.y - p1t.y * p2t.x;
-	Float e1 = p2t.x * p0t.y - p2t.y * p0t.x;
-	Float e2 = p0t.x * p1t.y - p0t.y * p1t.x;
-
-	// Fall back to double precision test at triangle edges
-	if (sizeof(Float) == sizeof(float) &&
-		(e0 == 0.0f || e1 == 0.0f || e2 == 0.0f))
-	{
-		double p2txp1ty = (double)p2t.x * (double)p1t.y;
-		double p2typ1tx = (double)p2t.y * (double)p1t.x;
-		e0 = (float)(p2typ1tx - p2txp1ty);
-		double p0txp2ty = (double)p0t.x * (double)p2t.y;
-		double p0typ2tx = (double)p0t.y * (double)p2t.x;
-		e1 = (float)(p0typ2tx - p0txp2ty);
-		double p1txp0ty = (double)p1t.x * (double)p0t.y;
-		double p1typ0tx = (double)p1t.y * (double)p0t.x;
-		e2 = (float)(p1typ0tx - p1txp0ty);
-	}
+	Float tHit, b0, b1, b2;
+	return hitTriangle(m_p0, m_p1, m_p2, ray, tHit, b0, b1, b2);
+}
 
-	// Perform triangle edge and determinant tests
-	if ((e0 < 0 || e1 < 0 || e2 < 0) && (e0 > 0 || e1 > 0 || e2 > 0))
-		return false;
-	Float det = e0 + e1 + e2;
-	if (det == 0)
+bool TriangleShape::hit(const Ray& ray, Float& tHit, SurfaceInteraction& isect) const
+{
+	Float t, b0, b1, b2;
+	if (!hitTriangle(m_p0, m_p1, m_p2, ray, t, b0, b1, b2))
 		return false;
 
-	// Compute scaled hit distance to triangle and test against ray $t$ range
-	p0t.z *= Sz;
-	p1t.z *= Sz;
-	p2t.z *= Sz;
-	Float tScaled = e0 * p0t.z + e1 * p1t.z + e2 * p2t.z;
-	if (det < 0 && (tScaled >= 0 || tScaled < ray.m_tMax * det))
+	const Vector2f uv[3] = { Vector2f(0,0), Vector2f(1,0), Vector2f(1,1) };
+	if (!computeTriangleInteraction(m_p0, m_p1, m_p2, uv, b0, b1, b2, ray, this, isect))
 		return false;
-	else if (det > 0 && (tScaled <= 0 || tScaled > ray.m_tMax * det))
-		return false;
-
-	// Compute barycentric coordinates and $t$ value for triangle intersection
-	Float invDet = 1 / det;
-	Float b0 = e0 * invDet;
-	Float b1 = e1 * invDet;
-	Float b2 = e2 * invDet;
-	Float t = tScaled * invDet;
 
-	// Ensure that computed triangle $t$ is conservatively greater than zero
+	tHit = t;
+	return true;
+}
 
-	// Compute $\delta_z$ term for triangle $t$ error bounds
-	Float maxZt = maxComponent(abs(Vector3f(p0t.z, p1t.z, p2t.z)));
-	Float deltaZ = gamma(3) * maxZt;
+bool TriangleShape::getTriangleVertices(Vector3f p[3]) const
+{
+	p[0] = m_p0;
+	p[1] = m_p1;
+	p[2] = m_p2;
+	return true;
+}
 
-	// Compute $\delta_x$ and $\delta_y$ terms for triangle $t$ error bounds
-	Float maxXt = maxComponent(abs(Vector3f(p0t.x, p1t.x, p2t.x)));
-	Float maxYt = maxComponent(abs(Vector3f(p0t.y, p1t.y, p2t.y)));
-	Float deltaX = gamma(5) * (maxXt + maxZt);
-	Float deltaY = gamma(5) * (maxYt + maxZt);
+Float TriangleShape::solidAngle(const Vector3f& p, int nSamples) const
+{
+	// Project the vertices into the unit sphere around p.
+	std::array<Vector3f, 3> pSphere = { normalize(m_p0 - p), normalize(m_p1 - p), normalize(m_p2 - p) };
 
-	// Compute $\delta_e$ term for triangle $t$ error bounds
-	Float deltaE = 2 * (gamma(2) * maxXt * maxYt + deltaY * maxXt + deltaX * maxYt);
+	// http://math.stackexchange.com/questions/9819/area-of-a-spherical-triangle
+	// Girard's theorem: surface area of a spherical triangle on a unit
+	// sphere is the 'excess angle' alpha+beta+gamma-pi, where
+	// alpha/beta/gamma are the interior angles at the vertices.
+	//
+	// Given three vertices on the sphere, a, b, c, then we can compute,
+	// for example, the angle c->a->b by
+	//
+	// cos theta =  Dot(Cross(c, a), Cross(b, a)) /
+	//              (Length(Cross(c, a)) * Length(Cross(b, a))).
+	//
+	Vector3f cross01 = (cross(pSphere[0], pSphere[1]));
+	Vector3f cross12 = (cross(pSphere[1], pSphere[2]));
+	Vector3f cross20 = (cross(pSphere[2], pSphere[0]));
 
-	// Compute $\delta_t$ term for triangle $t$ error bounds and check _t_
-	Float maxE = maxComponent(abs(Vector3f(e0, e1, e2)));
-	Float deltaT = 3 * (gamma(3) * maxE * maxZt + deltaE * maxZt + deltaZ * maxE) * glm::abs(invDet);
-	if (t <= deltaT)
-		return false;
+	// Some of these vectors may be degenerate. In this case, we don't want
+	// to normalize them so that we don't hit an assert. This is fine,
+	// since the corresponding dot products below will be zero.
+	if (lengthSquared(cross01) > 0) cross01 = normalize(cross01);
+	if (lengthSquared(cross12) > 0) cross12 = normalize(cross12);
+	if (lengthSquared(cross20) > 0) cross20 = normalize(cross20);
 
-	return true;
+	// We only need to do three cross products to evaluate the angles at
+	// all three vertices, though, since we can take advantage of the fact
+	// that Cross(a, b) = -Cross(b, a).
+	return glm::abs(
+		glm::acos(clamp(dot(cross01, -cross12), -1, 1)) +
+		glm::acos(clamp(dot(cross12, -cross20), -1, 1)) +
+		glm::acos(clamp(dot(cross20, -cross01), -1, 1)) - Pi);
 }
 
-bool TriangleShape::hit(const Ray& ray, Float& tHit, SurfaceInteraction& isect) const
-{
-	// Get triangle vertices in _p0_, _p1_, and _p2_
-	const Vector3f& p0 = m_p0;
-	const Vector3f& p1 = m_p1;
-	const Vector3f& p2 = m_p2;
+//-------------------------------------------Triangle kernels-------------------------------------
 
+bool hitTriangle(const Vector3f& p0, const Vector3f& p1, const Vector3f& p2, const Ray& ray,
+	Float& tHit, Float& b0, Float& b1, Float& b2)
+{
 	// Perform ray--triangle intersection test
 
 	// Transform triangle vertices to ray coordinate space
@@ -528,36 +485,34 @@ bool TriangleShape::hit(const Ray& ray, Float& tHit, SurfaceInteraction& isect)
 
 	// Compute barycentric coordinates and $t$ value for triangle intersection
 	Float invDet = 1 / det;
-	Float b0 = e0 * invDet;
-	Float b1 = e1 * invDet;
-	Float b2 = e2 * invDet;
+	b0 = e0 * invDet;
+	b1 = e1 * invDet;
+	b2 = e2 * invDet;
 	Float t = tScaled * invDet;
 
 	// Ensure that computed triangle $t$ is conservatively greater than zero
-
-	// Compute $\delta_z$ term for triangle $t$ error bounds
 	Float maxZt = maxComponent(abs(Vector3f(p0t.z, p1t.z, p2t.z)));
 	Float deltaZ = gamma(3) * maxZt;
-
-	// Compute $\delta_x$ and $\delta_y$ terms for triangle $t$ error bounds
 	Float maxXt = maxComponent(abs(Vector3f(p0t.x, p1t.x, p2t.x)));
 	Float maxYt = maxComponent(abs(Vector3f(p0t.y, p1t.y, p2t.y)));
 	Float deltaX = gamma(5) * (maxXt + maxZt);
 	Float deltaY = gamma(5) * (maxYt + maxZt);
-
-	// Compute $\delta_e$ term for triangle $t$ error bounds
 	Float deltaE = 2 * (gamma(2) * maxXt * maxYt + deltaY * maxXt + deltaX * maxYt);
-
-	// Compute $\delta_t$ term for triangle $t$ error bounds and check _t_
 	Float maxE = maxComponent(abs(Vector3f(e0, e1, e2)));
 	Float deltaT = 3 * (gamma(3) * maxE * maxZt + deltaE * maxZt + deltaZ * maxE) * glm::abs(invDet);
 	if (t <= deltaT)
 		return false;
 
+	tHit = t;
+	return true;
+}
+
+bool computeTriangleInteraction(const Vector3f& p0, const Vector3f& p1, const Vector3f& p2,
+	const Vector2f uv[3], Float b0, Float b1, Float b2, const Ray& ray, const Shape* shape,
+	SurfaceInteraction& isect)
+{
 	// Compute triangle partial derivatives
 	Vector3f dpdu, dpdv;
-	Vector2f uv[3] = { Vector2f(0,0), Vector2f(1,0), Vector2f(1,1) };
-	//GetUVs(uv);
 
 	// Compute deltas for triangle partial derivatives
 	Vector2f duv02 = uv[0] - uv[2], duv12 = uv[1] - uv[2];
@@ -586,49 +541,162 @@ bool TriangleShape::hit(const Ray& ray, Float& tHit, SurfaceInteraction& isect)
 	Vector2f uvHit = b0 * uv[0] + b1 * uv[1] + b2 * uv[2];
 
 	// Fill in _SurfaceInteraction_ from triangle hit
-	isect = SurfaceInteraction(pHit, uvHit, -ray.direction(), dpdu, dpdv, this);
+	isect = SurfaceInteraction(pHit, uvHit, -ray.direction(), dpdu, dpdv, shape);
 
 	// Override surface normal in _isect_ for triangle
 	isect.normal = Vector3f(normalize(cross(dp02, dp12)));
-	tHit = t;
-
 	return true;
 }
 
-Float TriangleShape::solidAngle(const Vector3f& p, int nSamples) const
+//Note: the SIMD kernels mirror hitTriangle() operation by operation, so every lane
+//      produces exactly the same result as the scalar test. Lanes whose edge functions
+//      evaluate to zero need the double precision fallback and are reported in
+//      _fallbackMask_ to be redone by hitTriangle().
+static inline int hitTriangleGroup(const float* const p[3][3], const int32_t* hitableIndex,
+	const float org[3], const int k[3], const float shear[3], float tMax, float tOut[4],
+	float tScaledOut[4], float detOut[4], int& fallbackMask)
 {
-	// Project the vertices into the unit sphere around p.
-	std::array<Vector3f, 3> pSphere = { normalize(m_p0 - p), normalize(m_p1 - p), normalize(m_p2 - p) };
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 absMask = _mm_castsi128_ps(_mm_set1_epi32(0x7fffffff));
+	const __m128 Sx = _mm_set1_ps(shear[0]), Sy = _mm_set1_ps(shear[1]), Sz = _mm_set1_ps(shear[2]);
 
-	// http://math.stackexchange.com/questions/9819/area-of-a-spherical-triangle
-	// Girard's theorem: surface area of a spherical triangle on a unit
-	// sphere is the 'excess angle' alpha+beta+gamma-pi, where
-	// alpha/beta/gamma are the interior angles at the vertices.
-	//
-	// Given three vertices on the sphere, a, b, c, then we can compute,
-	// for example, the angle c->a->b by
-	//
-	// cos theta =  Dot(Cross(c, a), Cross(b, a)) /
-	//              (Length(Cross(c, a)) * Length(Cross(b, a))).
-	//
-	Vector3f cross01 = (cross(pSphere[0], pSphere[1]));
-	Vector3f cross12 = (cross(pSphere[1], pSphere[2]));
-	Vector3f cross20 = (cross(pSphere[2], pSphere[0]));
+	// Translate, permute and shear the vertices, $z$ is scaled after the edge tests
+	__m128 x[3], y[3], z[3];
+	for (int v = 0; v < 3; ++v)
+	{
+		x[v] = _mm_sub_ps(_mm_load_ps(p[v][k[0]]), _mm_set1_ps(org[k[0]]));
+		y[v] = _mm_sub_ps(_mm_load_ps(p[v][k[1]]), _mm_set1_ps(org[k[1]]));
+		z[v] = _mm_sub_ps(_mm_load_ps(p[v][k[2]]), _mm_set1_ps(org[k[2]]));
+		x[v] = _mm_add_ps(x[v], _mm_mul_ps(Sx, z[v]));
+		y[v] = _mm_add_ps(y[v], _mm_mul_ps(Sy, z[v]));
+	}
 
-	// Some of these vectors may be degenerate. In this case, we don't want
-	// to normalize them so that we don't hit an assert. This is fine,
-	// since the corresponding dot products below will be zero.
-	if (lengthSquared(cross01) > 0) cross01 = normalize(cross01);
-	if (lengthSquared(cross12) > 0) cross12 = normalize(cross12);
-	if (lengthSquared(cross20) > 0) cross20 = normalize(cross20);
+	// Compute edge function coefficients _e0_, _e1_, and _e2_
+	__m128 e0 = _mm_sub_ps(_mm_mul_ps(x[1], y[2]), _mm_mul_ps(y[1], x[2]));
+	__m128 e1 = _mm_sub_ps(_mm_mul_ps(x[2], y[0]), _mm_mul_ps(y[2], x[0]));
+	__m128 e2 = _mm_sub_ps(_mm_mul_ps(x[0], y[1]), _mm_mul_ps(y[0], x[1]));
 
-	// We only need to do three cross products to evaluate the angles at
-	// all three vertices, though, since we can take advantage of the fact
-	// that Cross(a, b) = -Cross(b, a).
-	return glm::abs(
-		glm::acos(clamp(dot(cross01, -cross12), -1, 1)) +
-		glm::acos(clamp(dot(cross12, -cross20), -1, 1)) +
-		glm::acos(clamp(dot(cross20, -cross01), -1, 1)) - Pi);
+	__m128 valid = _mm_castsi128_ps(_mm_cmpgt_epi32(
+		_mm_loadu_si128((const __m128i*)hitableIndex), _mm_set1_epi32(-1)));
+	__m128 edgeZero = _mm_or_ps(_mm_or_ps(_mm_cmpeq_ps(e0, zero), _mm_cmpeq_ps(e1, zero)), _mm_cmpeq_ps(e2, zero));
+	fallbackMask = _mm_movemask_ps(_mm_and_ps(edgeZero, valid));
+	valid = _mm_andnot_ps(edgeZero, valid);
+
+	// Perform triangle edge and determinant tests
+	__m128 anyNeg = _mm_or_ps(_mm_or_ps(_mm_cmplt_ps(e0, zero), _mm_cmplt_ps(e1, zero)), _mm_cmplt_ps(e2, zero));
+	__m128 anyPos = _mm_or_ps(_mm_or_ps(_mm_cmpgt_ps(e0, zero), _mm_cmpgt_ps(e1, zero)), _mm_cmpgt_ps(e2, zero));
+	valid = _mm_andnot_ps(_mm_and_ps(anyNeg, anyPos), valid);
+	__m128 det = _mm_add_ps(_mm_add_ps(e0, e1), e2);
+	valid = _mm_andnot_ps(_mm_cmpeq_ps(det, zero), valid);
+
+	// Compute scaled hit distance to triangle and test against ray $t$ range
+	for (int v = 0; v < 3; ++v)
+		z[v] = _mm_mul_ps(z[v], Sz);
+	__m128 tScaled = _mm_add_ps(_mm_add_ps(_mm_mul_ps(e0, z[0]), _mm_mul_ps(e1, z[1])), _mm_mul_ps(e2, z[2]));
+	__m128 tMaxDet = _mm_mul_ps(_mm_set1_ps(tMax), det);
+	__m128 rejectNeg = _mm_and_ps(_mm_cmplt_ps(det, zero),
+		_mm_or_ps(_mm_cmpge_ps(tScaled, zero), _mm_cmplt_ps(tScaled, tMaxDet)));
+	__m128 rejectPos = _mm_and_ps(_mm_cmpgt_ps(det, zero),
+		_mm_or_ps(_mm_cmple_ps(tScaled, zero), _mm_cmpgt_ps(tScaled, tMaxDet)));
+	valid = _mm_andnot_ps(_mm_or_ps(rejectNeg, rejectPos), valid);
+	if (_mm_movemask_ps(valid) == 0)
+		return 0;
+
+	// Compute $t$ value and its conservative error bound $\delta_t$
+	__m128 invDet = _mm_div_ps(_mm_set1_ps(1.f), det);
+	__m128 t = _mm_mul_ps(tScaled, invDet);
+
+	__m128 maxZt = _mm_max_ps(_mm_and_ps(z[0], absMask), _mm_max_ps(_mm_and_ps(z[1], absMask), _mm_and_ps(z[2], absMask)));
+	__m128 maxXt = _mm_max_ps(_mm_and_ps(x[0], absMask), _mm_max_ps(_mm_and_ps(x[1], absMask), _mm_and_ps(x[2], absMask)));
+	__m128 maxYt = _mm_max_ps(_mm_and_ps(y[0], absMask), _mm_max_ps(_mm_and_ps(y[1], absMask), _mm_and_ps(y[2], absMask)));
+	__m128 deltaZ = _mm_mul_ps(_mm_set1_ps(gamma(3)), maxZt);
+	__m128 deltaX = _mm_mul_ps(_mm_set1_ps(gamma(5)), _mm_add_ps(maxXt, maxZt));
+	__m128 deltaY = _mm_mul_ps(_mm_set1_ps(gamma(5)), _mm_add_ps(maxYt, maxZt));
+	__m128 deltaE = _mm_mul_ps(_mm_set1_ps(2.f), _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(gamma(2)), maxXt), maxYt),
+		_mm_mul_ps(deltaY, maxXt)), _mm_mul_ps(deltaX, maxYt)));
+	__m128 maxE = _mm_max_ps(_mm_and_ps(e0, absMask), _mm_max_ps(_mm_and_ps(e1, absMask), _mm_and_ps(e2, absMask)));
+	__m128 deltaT = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(3.f), _mm_add_ps(_mm_add_ps(
+		_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(gamma(3)), maxE), maxZt),
+		_mm_mul_ps(deltaE, maxZt)), _mm_mul_ps(deltaZ, maxE))), _mm_and_ps(invDet, absMask));
+	valid = _mm_and_ps(_mm_cmpgt_ps(t, deltaT), valid);
+
+	_mm_storeu_ps(tOut, t);
+	_mm_storeu_ps(tScaledOut, tScaled);
+	_mm_storeu_ps(detOut, det);
+	return _mm_movemask_ps(valid);
+}
+
+template <int N>
+int hitTriangleBlock(const TriangleBlock<N>& block, const Ray& ray, Float& tHit)
+{
+	// Permute components of ray direction and compute the shear, as hitTriangle() does
+	int kz = maxDimension(abs(ray.direction()));
+	int kx = kz + 1;
+	if (kx == 3) kx = 0;
+	int ky = kx + 1;
+	if (ky == 3) ky = 0;
+	Vector3f d = permute(ray.direction(), kx, ky, kz);
+	const int k[3] = { kx, ky, kz };
+	const float shear[3] = { -d.x / d.z, -d.y / d.z, 1.f / d.z };
+	const float org[3] = { ray.m_origin.x, ray.m_origin.y, ray.m_origin.z };
+
+	int closest = -1;
+	Float tClosest = ray.m_tMax;
+	for (int g = 0; g < N; g += 4)
+	{
+		const float* const p[3][3] =
+		{
+			{ block.p0[0] + g, block.p0[1] + g, block.p0[2] + g },
+			{ block.p1[0] + g, block.p1[1] + g, block.p1[2] + g },
+			{ block.p2[0] + g, block.p2[1] + g, block.p2[2] + g }
+		};
+		float t[4], tScaled[4], det[4];
+		int fallbackMask;
+		int mask = hitTriangleGroup(p, block.hitableIndex + g, org, k, shear, ray.m_tMax,
+			t, tScaled, det, fallbackMask);
+		if ((mask | fallbackMask) == 0)
+			continue;
+
+		//Note: lanes are resolved in order against the shrinking $t$ range with the same
+		//      scaled comparison as hitTriangle(), so ties (e.g. coplanar lights) and
+		//      rounding match a sequential scan over the hitables.
+		for (int i = 0; i < 4; ++i)
+		{
+			int lane = g + i;
+			if (fallbackMask & (1 << i))
+			{
+				// Fall back to the scalar test with double precision edge functions
+				Vector3f p0(block.p0[0][lane], block.p0[1][lane], block.p0[2][lane]);
+				Vector3f p1(block.p1[0][lane], block.p1[1][lane], block.p1[2][lane]);
+				Vector3f p2(block.p2[0][lane], block.p2[1][lane], block.p2[2][lane]);
+				Ray r = ray;
+				r.m_tMax = tClosest;
+				Float tLane, b0, b1, b2;
+				if (hitTriangle(p0, p1, p2, r, tLane, b0, b1, b2))
+				{
+					closest = lane;
+					tClosest = tLane;
+				}
+			}
+			else if (mask & (1 << i))
+			{
+				bool inRange = det[i] < 0 ? tScaled[i] >= tClosest * det[i] : tScaled[i] <= tClosest * det[i];
+				if (inRange)
+				{
+					closest = lane;
+					tClosest = t[i];
+				}
+			}
+		}
+	}
+
+	if (closest >= 0)
+		tHit = tClosest;
+	return closest;
 }
 
+template int hitTriangleBlock<4>(const TriangleBlock<4>& block, const Ray& ray, Float& tHit);
+template int hitTriangleBlock<8>(const TriangleBlock<8>& block, const Ray& ray, Float& tHit);
+
 RENDER_END
\ No newline at end of file
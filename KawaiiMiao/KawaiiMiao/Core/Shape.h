@@ -40,6 +40,10 @@ public:
 	// used in this case.
 	virtual Float solidAngle(const Vector3f& p, int nSamples = 512) const;
 
+	//Note: world space vertices of single triangle shapes, used to pack BVH leaves
+	//      into SIMD triangle blocks. Other shapes return false.
+	virtual bool getTriangleVertices(Vector3f p[3]) const { return false; }
+
 public:
 	Transform m_objectToWorld, m_worldToObject;
 };
@@ -92,8 +96,38 @@ public:
 
 	virtual Float solidAngle(const Vector3f& p, int nSamples = 512) const override;
 
+	virtual bool getTriangleVertices(Vector3f p[3]) const override;
+
 private:
 	Vector3f m_p0, m_p1, m_p2;
 };
 
+// Watertight ray--triangle test (pbrt 3.6.2), returns the hit distance and the barycentrics
+bool hitTriangle(const Vector3f& p0, const Vector3f& p1, const Vector3f& p2, const Ray& ray,
+	Float& tHit, Float& b0, Float& b1, Float& b2);
+
+// Fills in _isect_ for a hit found by hitTriangle(), returns false for degenerate triangles
+bool computeTriangleInteraction(const Vector3f& p0, const Vector3f& p1, const Vector3f& p2,
+	const Vector2f uv[3], Float b0, Float b1, Float b2, const Ray& ray, const Shape* shape,
+	SurfaceInteraction& isect);
+
+//Note: N triangles stored as SoA vertices, the SSE kernel tests one ray against four
+//      lanes at a time (an 8-wide block runs as two groups). No edges are stored since
+//      the watertight test shears the translated vertices for every ray anyway.
+//      Empty lanes have a negative hitable index.
+template <int N>
+struct alignas(32) TriangleBlock
+{
+	float p0[3][N];
+	float p1[3][N];
+	float p2[3][N];
+	int32_t hitableIndex[N];
+};
+
+// Returns the lane of the closest triangle in _block_ hit before ray.m_tMax, or -1.
+// The result is bit-exact with hitTriangle(), so the surface differentials can be
+// computed afterwards for the winning triangle only.
+template <int N>
+int hitTriangleBlock(const TriangleBlock<N>& block, const Ray& ray, Float& tHit);
+
 RENDER_END
\ No newline at end of file
@@ -2,6 +2,9 @@
 
 #include "Rendering.h"
 
+#include <immintrin.h>
+#include <type_traits>
+
 RENDER_BEGIN
 
 inline void XYZToRGB(const Float xyz[3], Float rgb[3])
@@ -20,85 +23,259 @@ inline void RGBToXYZ(const Float rgb[3], Float xyz[3])
 
 enum class SpectrumType { Reflectance, Illuminant };
 
+//Note: SIMD lanes the coefficient spectra are processed with. SSE is always there on x64,
+//      spectra of at least 8 (16) samples take AVX (AVX-512) registers when the build
+//      enables them. Double precision builds stay scalar.
+#ifndef FLOAT_AS_DOUBLE
+struct SpectrumLanes4
+{
+	typedef __m128 Vec;
+	static CONSTEXPR int Width = 4;
+
+	static Vec load(const Float* p) { return _mm_loadu_ps(p); }
+	static void store(Float* p, Vec v) { _mm_storeu_ps(p, v); }
+	static Vec set1(Float v) { return _mm_set1_ps(v); }
+	static Vec add(Vec a, Vec b) { return _mm_add_ps(a, b); }
+	static Vec sub(Vec a, Vec b) { return _mm_sub_ps(a, b); }
+	static Vec mul(Vec a, Vec b) { return _mm_mul_ps(a, b); }
+	static Vec div(Vec a, Vec b) { return _mm_div_ps(a, b); }
+	static Vec neg(Vec a) { return _mm_xor_ps(a, _mm_set1_ps(-0.f)); }
+	static Vec sqrt(Vec a) { return _mm_sqrt_ps(a); }
+	//Note: NaNs in _a_ come out as the bound, the scalar loops kept them
+	static Vec clamp(Vec a, Float low, Float high) { return _mm_max_ps(_mm_min_ps(a, set1(high)), set1(low)); }
+
+	// Cephes expf, relative error below 2 ulp over the clamped range
+	static Vec exp(Vec x)
+	{
+		x = _mm_max_ps(_mm_min_ps(x, _mm_set1_ps(88.3762626647949f)), _mm_set1_ps(-88.3762626647949f));
+
+		// Express exp(x) as 2^n * exp(g) with |g| <= ln(2) / 2
+		__m128 fx = _mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(1.44269504088896341f)), _mm_set1_ps(0.5f));
+		__m128 tmp = _mm_cvtepi32_ps(_mm_cvttps_epi32(fx));
+		fx = _mm_sub_ps(tmp, _mm_and_ps(_mm_cmpgt_ps(tmp, fx), _mm_set1_ps(1.f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(0.693359375f)));
+		x = _mm_sub_ps(x, _mm_mul_ps(fx, _mm_set1_ps(-2.12194440e-4f)));
+
+		__m128 z = _mm_mul_ps(x, x);
+		__m128 y = _mm_set1_ps(1.9875691500e-4f);
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.3981999507e-3f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(8.3334519073e-3f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(4.1665795894e-2f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(1.6666665459e-1f));
+		y = _mm_add_ps(_mm_mul_ps(y, x), _mm_set1_ps(5.0000001201e-1f));
+		y = _mm_add_ps(_mm_add_ps(_mm_mul_ps(y, z), x), _mm_set1_ps(1.f));
+
+		// Scale by 2^n through the exponent bits
+		__m128i n = _mm_slli_epi32(_mm_add_epi32(_mm_cvttps_epi32(fx), _mm_set1_epi32(0x7f)), 23);
+		return _mm_mul_ps(y, _mm_castsi128_ps(n));
+	}
+
+	static bool anyNonZero(Vec a) { return _mm_movemask_ps(_mm_cmpneq_ps(a, _mm_setzero_ps())) != 0; }
+	static bool anyNaN(Vec a) { return _mm_movemask_ps(_mm_cmpunord_ps(a, a)) != 0; }
+	static bool anyNotEqual(Vec a, Vec b) { return _mm_movemask_ps(_mm_cmpneq_ps(a, b)) != 0; }
+	static Float sum(Vec a)
+	{
+		__m128 s = _mm_add_ps(a, _mm_movehl_ps(a, a));
+		return _mm_cvtss_f32(_mm_add_ss(s, _mm_shuffle_ps(s, s, 1)));
+	}
+};
+
+#ifdef __AVX__
+struct SpectrumLanes8
+{
+	typedef __m256 Vec;
+	static CONSTEXPR int Width = 8;
+
+	static Vec load(const Float* p) { return _mm256_loadu_ps(p); }
+	static void store(Float* p, Vec v) { _mm256_storeu_ps(p, v); }
+	static Vec set1(Float v) { return _mm256_set1_ps(v); }
+	static Vec add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+	static Vec sub(Vec a, Vec b) { return _mm256_sub_ps(a, b); }
+	static Vec mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+	static Vec div(Vec a, Vec b) { return _mm256_div_ps(a, b); }
+	static Vec neg(Vec a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.f)); }
+	static Vec sqrt(Vec a) { return _mm256_sqrt_ps(a); }
+	static Vec clamp(Vec a, Float low, Float high) { return _mm256_max_ps(_mm256_min_ps(a, set1(high)), set1(low)); }
+
+	//Note: AVX has no 256 bit integer operations, the exponent is built in two SSE halves
+	static Vec exp(Vec x)
+	{
+		return _mm256_insertf128_ps(_mm256_castps128_ps256(SpectrumLanes4::exp(_mm256_castps256_ps128(x))),
+			SpectrumLanes4::exp(_mm256_extractf128_ps(x, 1)), 1);
+	}
+
+	static bool anyNonZero(Vec a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, _mm256_setzero_ps(), _CMP_NEQ_UQ)) != 0; }
+	static bool anyNaN(Vec a) { return _mm256_movemask_ps(_mm256_cmp_ps(a, a, _CMP_UNORD_Q)) != 0; }
+	static bool anyNotEqual(Vec a, Vec b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_NEQ_UQ)) != 0; }
+	static Float sum(Vec a)
+	{
+		return SpectrumLanes4::sum(_mm_add_ps(_mm256_castps256_ps128(a), _mm256_extractf128_ps(a, 1)));
+	}
+};
+#endif
+
+#ifdef __AVX512F__
+struct SpectrumLanes16
+{
+	typedef __m512 Vec;
+	static CONSTEXPR int Width = 16;
+
+	static Vec load(const Float* p) { return _mm512_loadu_ps(p); }
+	static void store(Float* p, Vec v) { _mm512_storeu_ps(p, v); }
+	static Vec set1(Float v) { return _mm512_set1_ps(v); }
+	static Vec add(Vec a, Vec b) { return _mm512_add_ps(a, b); }
+	static Vec sub(Vec a, Vec b) { return _mm512_sub_ps(a, b); }
+	static Vec mul(Vec a, Vec b) { return _mm512_mul_ps(a, b); }
+	static Vec div(Vec a, Vec b) { return _mm512_div_ps(a, b); }
+	static Vec neg(Vec a) { return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x80000000))); }
+	static Vec sqrt(Vec a) { return _mm512_sqrt_ps(a); }
+	static Vec clamp(Vec a, Float low, Float high) { return _mm512_max_ps(_mm512_min_ps(a, set1(high)), set1(low)); }
+
+	static Vec exp(Vec x)
+	{
+		Vec ret = x;
+		ret = _mm512_insertf32x4(ret, SpectrumLanes4::exp(_mm512_extractf32x4_ps(x, 0)), 0);
+		ret = _mm512_insertf32x4(ret, SpectrumLanes4::exp(_mm512_extractf32x4_ps(x, 1)), 1);
+		ret = _mm512_insertf32x4(ret, SpectrumLanes4::exp(_mm512_extractf32x4_ps(x, 2)), 2);
+		ret = _mm512_insertf32x4(ret, SpectrumLanes4::exp(_mm512_extractf32x4_ps(x, 3)), 3);
+		return ret;
+	}
+
+	static bool anyNonZero(Vec a) { return _mm512_cmp_ps_mask(a, _mm512_setzero_ps(), _CMP_NEQ_UQ) != 0; }
+	static bool anyNaN(Vec a) { return _mm512_cmp_ps_mask(a, a, _CMP_UNORD_Q) != 0; }
+	static bool anyNotEqual(Vec a, Vec b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ) != 0; }
+	static Float sum(Vec a) { return _mm512_reduce_add_ps(a); }
+};
+#endif
+
+#else
+struct SpectrumLanes1
+{
+	typedef Float Vec;
+	static CONSTEXPR int Width = 1;
+
+	static Vec load(const Float* p) { return *p; }
+	static void store(Float* p, Vec v) { *p = v; }
+	static Vec set1(Float v) { return v; }
+	static Vec add(Vec a, Vec b) { return a + b; }
+	static Vec sub(Vec a, Vec b) { return a - b; }
+	static Vec mul(Vec a, Vec b) { return a * b; }
+	static Vec div(Vec a, Vec b) { return a / b; }
+	static Vec neg(Vec a) { return -a; }
+	static Vec sqrt(Vec a) { return glm::sqrt(a); }
+	static Vec clamp(Vec a, Float low, Float high) { return Render::clamp(a, low, high); }
+	static Vec exp(Vec a) { return glm::exp(a); }
+	static bool anyNonZero(Vec a) { return a != 0.; }
+	static bool anyNaN(Vec a) { return glm::isnan(a); }
+	static bool anyNotEqual(Vec a, Vec b) { return a != b; }
+	static Float sum(Vec a) { return a; }
+};
+#endif
+
+template <int nSpectrumSamples>
+struct SpectrumLanesFor
+{
+#if defined(FLOAT_AS_DOUBLE)
+	typedef SpectrumLanes1 type;
+#elif defined(__AVX512F__)
+	typedef typename std::conditional<(nSpectrumSamples >= 16), SpectrumLanes16,
+		typename std::conditional<(nSpectrumSamples >= 8), SpectrumLanes8, SpectrumLanes4>::type>::type type;
+#elif defined(__AVX__)
+	typedef typename std::conditional<(nSpectrumSamples >= 8), SpectrumLanes8, SpectrumLanes4>::type type;
+#else
+	typedef SpectrumLanes4 type;
+#endif
+};
+
 template <int nSpectrumSamples>
 class CoefficientSpectrum
 {
+	typedef typename SpectrumLanesFor<nSpectrumSamples>::type Lanes;
+
 public:
+	//Note: the coefficients are padded to whole SIMD registers, every operator works on all
+	//      lanes and keeps the padding at 0, which isBlack(), hasNaNs() and == rely on.
+	static CONSTEXPR int nPaddedSamples = (nSpectrumSamples + Lanes::Width - 1) / Lanes::Width * Lanes::Width;
+
 	CoefficientSpectrum(Float v = 0.f)
 	{
 		for (int i = 0; i < nSpectrumSamples; ++i)
 			c[i] = v;
+		clearPadding();
 		DCHECK(!hasNaNs());
 	}
 
 	CoefficientSpectrum& operator+=(const CoefficientSpectrum& s2)
 	{
 		DCHECK(!s2.hasNaNs());
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			c[i] += s2.c[i];
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(c + i, Lanes::add(Lanes::load(c + i), Lanes::load(s2.c + i)));
 		return *this;
 	}
 
 	CoefficientSpectrum operator+(const CoefficientSpectrum& s2) const
 	{
 		DCHECK(!s2.hasNaNs());
-		CoefficientSpectrum ret = *this;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] += s2.c[i];
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::add(Lanes::load(c + i), Lanes::load(s2.c + i)));
 		return ret;
 	}
 
 	CoefficientSpectrum operator-(const CoefficientSpectrum& s2) const
 	{
 		DCHECK(!s2.hasNaNs());
-		CoefficientSpectrum ret = *this;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] -= s2.c[i];
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::sub(Lanes::load(c + i), Lanes::load(s2.c + i)));
 		return ret;
 	}
 
 	CoefficientSpectrum operator/(const CoefficientSpectrum& s2) const
 	{
 		DCHECK(!s2.hasNaNs());
-		CoefficientSpectrum ret = *this;
 		for (int i = 0; i < nSpectrumSamples; ++i)
-		{
 			CHECK_NE(s2.c[i], 0);
-			ret.c[i] /= s2.c[i];
-		}
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::div(Lanes::load(c + i), Lanes::load(s2.c + i)));
+		// 0 / 0 in the padding
+		ret.clearPadding();
 		return ret;
 	}
 
 	CoefficientSpectrum operator*(const CoefficientSpectrum& sp) const
 	{
 		DCHECK(!sp.hasNaNs());
-		CoefficientSpectrum ret = *this;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] *= sp.c[i];
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::mul(Lanes::load(c + i), Lanes::load(sp.c + i)));
 		return ret;
 	}
 
 	CoefficientSpectrum& operator*=(const CoefficientSpectrum& sp)
 	{
 		DCHECK(!sp.hasNaNs());
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			c[i] *= sp.c[i];
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(c + i, Lanes::mul(Lanes::load(c + i), Lanes::load(sp.c + i)));
 		return *this;
 	}
 
 	CoefficientSpectrum operator*(Float a) const
 	{
-		CoefficientSpectrum ret = *this;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] *= a;
+		const typename Lanes::Vec va = Lanes::set1(a);
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::mul(Lanes::load(c + i), va));
 		DCHECK(!ret.hasNaNs());
 		return ret;
 	}
 
 	CoefficientSpectrum& operator*=(Float a)
 	{
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			c[i] *= a;
+		const typename Lanes::Vec va = Lanes::set1(a);
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(c + i, Lanes::mul(Lanes::load(c + i), va));
 		DCHECK(!hasNaNs());
 		return *this;
 	}
@@ -114,8 +291,7 @@ public:
 		CHECK_NE(a, 0);
 		DCHECK(!glm::isnan(a));
 		CoefficientSpectrum ret = *this;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] /= a;
+		ret /= a;
 		DCHECK(!ret.hasNaNs());
 		return ret;
 	}
@@ -124,16 +300,17 @@ public:
 	{
 		CHECK_NE(a, 0);
 		DCHECK(!glm::isnan(a));
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			c[i] /= a;
+		const typename Lanes::Vec va = Lanes::set1(a);
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(c + i, Lanes::div(Lanes::load(c + i), va));
 		return *this;
 	}
 
 	bool operator==(const CoefficientSpectrum& sp) const
 	{
-		for (int i = 0; i < nSpectrumSamples; ++i)
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
 		{
-			if (c[i] != sp.c[i])
+			if (Lanes::anyNotEqual(Lanes::load(c + i), Lanes::load(sp.c + i)))
 				return false;
 		}
 		return true;
@@ -146,9 +323,9 @@ public:
 
 	bool isBlack() const
 	{
-		for (int i = 0; i < nSpectrumSamples; ++i)
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
 		{
-			if (c[i] != 0.)
+			if (Lanes::anyNonZero(Lanes::load(c + i)))
 				return false;
 		}
 		return true;
@@ -156,9 +333,9 @@ public:
 
 	friend CoefficientSpectrum sqrt(const CoefficientSpectrum& s)
 	{
-		CoefficientSpectrum ret;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] = glm::sqrt(s.c[i]);
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::sqrt(Lanes::load(s.c + i)));
 		DCHECK(!ret.hasNaNs());
 		return ret;
 	}
@@ -168,21 +345,41 @@ public:
 
 	CoefficientSpectrum operator-() const
 	{
-		CoefficientSpectrum ret;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] = -c[i];
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::neg(Lanes::load(c + i)));
 		return ret;
 	}
 
 	friend CoefficientSpectrum exp(const CoefficientSpectrum& s)
 	{
-		CoefficientSpectrum ret;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] = glm::exp(s.c[i]);
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::exp(Lanes::load(s.c + i)));
+		// exp(0) = 1 in the padding
+		ret.clearPadding();
 		DCHECK(!ret.hasNaNs());
 		return ret;
 	}
 
+	// Sum of the coefficients weighted by _w_, which is padded like the spectrum
+	Float weightedSum(const Float w[nPaddedSamples]) const
+	{
+		// A horizontal add costs more than it saves within a single register
+		if (nPaddedSamples == Lanes::Width)
+		{
+			Float sum = c[0] * w[0];
+			for (int i = 1; i < nSpectrumSamples; ++i)
+				sum += c[i] * w[i];
+			return sum;
+		}
+
+		typename Lanes::Vec acc = Lanes::mul(Lanes::load(c), Lanes::load(w));
+		for (int i = Lanes::Width; i < nPaddedSamples; i += Lanes::Width)
+			acc = Lanes::add(acc, Lanes::mul(Lanes::load(c + i), Lanes::load(w + i)));
+		return Lanes::sum(acc);
+	}
+
 	friend std::ostream& operator<<(std::ostream& os, const CoefficientSpectrum& s)
 	{
 		return os << s.toString();
@@ -203,9 +400,10 @@ public:
 
 	CoefficientSpectrum clamp(Float low = 0, Float high = Infinity) const
 	{
-		CoefficientSpectrum ret;
-		for (int i = 0; i < nSpectrumSamples; ++i)
-			ret.c[i] = Render::clamp(c[i], low, high);
+		CoefficientSpectrum ret(NoInit{});
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
+			Lanes::store(ret.c + i, Lanes::clamp(Lanes::load(c + i), low, high));
+		ret.clearPadding();
 		DCHECK(!ret.hasNaNs());
 		return ret;
 	}
@@ -220,9 +418,9 @@ public:
 
 	bool hasNaNs() const
 	{
-		for (int i = 0; i < nSpectrumSamples; ++i)
+		for (int i = 0; i < nPaddedSamples; i += Lanes::Width)
 		{
-			if (glm::isnan(c[i]))
+			if (Lanes::anyNaN(Lanes::load(c + i)))
 				return true;
 		}
 		return false;
@@ -243,7 +441,17 @@ public:
 	static const int nSamples = nSpectrumSamples;
 
 protected:
-	Float c[nSpectrumSamples];
+	//Note: for results that write every lane anyway
+	struct NoInit {};
+	explicit CoefficientSpectrum(NoInit) {}
+
+	void clearPadding()
+	{
+		for (int i = nSpectrumSamples; i < nPaddedSamples; ++i)
+			c[i] = 0;
+	}
+
+	alignas(Lanes::Width * sizeof(Float)) Float c[nPaddedSamples];
 };
 
 class RGBSpectrum : public CoefficientSpectrum<3>
@@ -272,7 +480,15 @@ public:
 		rgb[2] = c[2];
 	}
 
-	void toXYZ(Float xyz[3]) const { RGBToXYZ(c, xyz); }
+	void toXYZ(Float xyz[3]) const
+	{
+		alignas(16) static CONSTEXPR Float XWeight[nPaddedSamples] = { 0.412453f, 0.357580f, 0.180423f };
+		alignas(16) static CONSTEXPR Float YWeight[nPaddedSamples] = { 0.212671f, 0.715160f, 0.072169f };
+		alignas(16) static CONSTEXPR Float ZWeight[nPaddedSamples] = { 0.019334f, 0.119193f, 0.950227f };
+		xyz[0] = weightedSum(XWeight);
+		xyz[1] = weightedSum(YWeight);
+		xyz[2] = weightedSum(ZWeight);
+	}
 	const RGBSpectrum& toRGBSpectrum() const { return *this; }
 
 	static RGBSpectrum fromXYZ(const Float xyz[3], SpectrumType type = SpectrumType::Reflectance)
@@ -284,8 +500,8 @@ public:
 
 	Float y() const
 	{
-		const Float YWeight[3] = { 0.212671f, 0.715160f, 0.072169f };
-		return YWeight[0] * c[0] + YWeight[1] * c[1] + YWeight[2] * c[2];
+		alignas(16) static CONSTEXPR Float YWeight[nPaddedSamples] = { 0.212671f, 0.715160f, 0.072169f };
+		return weightedSum(YWeight);
 	}
 };
 
@@ -299,6 +515,7 @@ inline CoefficientSpectrum<nSpectrumSamples> pow(
 	{
 		ret.c[i] = glm::pow(s.c[i], e);
 	}
+	ret.clearPadding();
 	DCHECK(!ret.hasNaNs());
 	return ret;
 }
@@ -0,0 +1,158 @@
+#include "TriangleMesh.h"
+
+#include "Interaction.h"
+
+RENDER_BEGIN
+
+//-------------------------------------------TriangleMesh-------------------------------------
+
+TriangleMesh::TriangleMesh(const Transform& objectToWorld, int nTriangles, const int* indices,
+	int nVertices, const Vector3f* P, const Vector3f* N, const Vector2f* UV,
+	const Material::ptr& material)
+	: m_nTriangles(nTriangles), m_nVertices(nVertices),
+	m_material(material), m_indexBuffer(indices, indices + 3 * nTriangles)
+{
+	m_indices = m_indexBuffer.data();
+	transformVertices(objectToWorld, P, N);
+
+	if (UV != nullptr)
+	{
+		m_uvBuffer.assign(UV, UV + nVertices);
+		m_uv = m_uvBuffer.data();
+	}
+	buildTriangles();
+}
+
+TriangleMesh::TriangleMesh(const Transform& objectToWorld, int nTriangles, const int* indices,
+	int nVertices, const Vector3f* P, const Vector3f* N, const Vector2f* UV,
+	const Material::ptr& material, std::shared_ptr<const void> storage)
+	: m_nTriangles(nTriangles), m_nVertices(nVertices), m_indices(indices), m_uv(UV),
+	m_material(material), m_storage(std::move(storage))
+{
+	if (objectToWorld.isIdentity())
+	{
+		// Reference the vertex data in place
+		m_p = P;
+		m_n = N;
+	}
+	else
+		transformVertices(objectToWorld, P, N);
+	buildTriangles();
+}
+
+void TriangleMesh::buildTriangles()
+{
+	m_triangles.reserve(m_nTriangles);
+	for (int i = 0; i < m_nTriangles; ++i)
+		m_triangles.emplace_back(this, i);
+}
+
+void TriangleMesh::transformVertices(const Transform& objectToWorld, const Vector3f* P, const Vector3f* N)
+{
+	// Transform mesh vertices to world space
+	m_pBuffer.resize(m_nVertices);
+	for (int i = 0; i < m_nVertices; ++i)
+		m_pBuffer[i] = objectToWorld(P[i], 1.0f);
+	m_p = m_pBuffer.data();
+
+	if (N != nullptr)
+	{
+		//Note: normals are transformed by the inverse transpose matrix.
+		Transform normalToWorld = transpose(inverse(objectToWorld));
+		m_nBuffer.resize(m_nVertices);
+		for (int i = 0; i < m_nVertices; ++i)
+			m_nBuffer[i] = normalize(normalToWorld(N[i], 0.0f));
+		m_n = m_nBuffer.data();
+	}
+}
+
+void TriangleMesh::createTriangles(const TriangleMesh::ptr& mesh, std::vector<Hitable::ptr>& hitables)
+{
+	for (int i = 0; i < mesh->m_nTriangles; ++i)
+		hitables.push_back(Hitable::ptr(mesh, &mesh->m_triangles[i]));
+}
+
+//-------------------------------------------Triangle-------------------------------------
+
+const int* Triangle::vertices() const { return m_mesh->m_indices + 3 * m_triNumber; }
+
+Bounds3f Triangle::worldBound() const
+{
+	const int* v = vertices();
+	return unionBounds(Bounds3f(m_mesh->m_p[v[0]], m_mesh->m_p[v[1]]), m_mesh->m_p[v[2]]);
+}
+
+Float Triangle::area() const
+{
+	const int* v = vertices();
+	const Vector3f& p0 = m_mesh->m_p[v[0]];
+	const Vector3f& p1 = m_mesh->m_p[v[1]];
+	const Vector3f& p2 = m_mesh->m_p[v[2]];
+	return 0.5 * length(cross(p1 - p0, p2 - p0));
+}
+
+bool Triangle::hit(const Ray& ray) const
+{
+	const int* v = vertices();
+	Float tHit, b0, b1, b2;
+	return hitTriangle(m_mesh->m_p[v[0]], m_mesh->m_p[v[1]], m_mesh->m_p[v[2]], ray, tHit, b0, b1, b2);
+}
+
+bool Triangle::hit(const Ray& ray, SurfaceInteraction& isect) const
+{
+	const int* v = vertices();
+	const Vector3f& p0 = m_mesh->m_p[v[0]];
+	const Vector3f& p1 = m_mesh->m_p[v[1]];
+	const Vector3f& p2 = m_mesh->m_p[v[2]];
+
+	Float tHit, b0, b1, b2;
+	if (!hitTriangle(p0, p1, p2, ray, tHit, b0, b1, b2))
+		return false;
+
+	Vector2f uv[3] = { Vector2f(0,0), Vector2f(1,0), Vector2f(1,1) };
+	if (m_mesh->m_uv != nullptr)
+	{
+		uv[0] = m_mesh->m_uv[v[0]];
+		uv[1] = m_mesh->m_uv[v[1]];
+		uv[2] = m_mesh->m_uv[v[2]];
+	}
+
+	if (!computeTriangleInteraction(p0, p1, p2, uv, b0, b1, b2, ray, nullptr, isect))
+		return false;
+
+	//Note: there are no separate shading normals yet, the vertex normals
+	//      only decide the orientation of the geometric normal.
+	if (m_mesh->m_n != nullptr)
+	{
+		Vector3f ns = b0 * m_mesh->m_n[v[0]] + b1 * m_mesh->m_n[v[1]] + b2 * m_mesh->m_n[v[2]];
+		isect.normal = faceforward(isect.normal, ns);
+	}
+
+	ray.m_tMax = tHit;
+	isect.hitable = this;
+	return true;
+}
+
+bool Triangle::getTriangleVertices(Vector3f p[3]) const
+{
+	const int* v = vertices();
+	p[0] = m_mesh->m_p[v[0]];
+	p[1] = m_mesh->m_p[v[1]];
+	p[2] = m_mesh->m_p[v[2]];
+	return true;
+}
+
+const AreaLight* Triangle::getAreaLight() const { return nullptr; }
+
+const Material* Triangle::getMaterial() const { return m_mesh->m_material.get(); }
+
+void Triangle::computeScatteringFunctions(SurfaceInteraction& isect, MemoryArena& arena,
+	TransportMode mode, bool allowMultipleLobes) const
+{
+	if (m_mesh->m_material != nullptr)
+	{
+		m_mesh->m_material->computeScatteringFunctions(isect, arena, mode, allowMultipleLobes);
+	}
+}
+
+RENDER_END
\ No newline at end of file
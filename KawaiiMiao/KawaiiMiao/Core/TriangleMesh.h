@@ -0,0 +1,92 @@
+#pragma once
+
+#include "Rendering.h"
+#include "Primitive.h"
+#include "../Math/KMathUtil.h"
+#include "../Math/Transform.h"
+
+#include <vector>
+
+RENDER_BEGIN
+
+class TriangleMesh;
+
+//Note: a triangle of an indexed mesh is just a (mesh pointer, index) pair, all vertex
+//      data lives in the mesh. sizeof(Triangle) -> 24 bytes including the vptr.
+class Triangle final : public Hitable
+{
+public:
+	Triangle(const TriangleMesh* mesh, int triNumber) : m_mesh(mesh), m_triNumber(triNumber) {}
+
+	virtual Bounds3f worldBound() const override;
+	virtual bool hit(const Ray& ray) const override;
+	virtual bool hit(const Ray& ray, SurfaceInteraction& iset) const override;
+	virtual bool getTriangleVertices(Vector3f p[3]) const override;
+
+	virtual const AreaLight* getAreaLight() const override;
+	virtual const Material* getMaterial() const override;
+
+	virtual void computeScatteringFunctions(SurfaceInteraction& isect, MemoryArena& arena,
+		TransportMode mode, bool allowMultipleLobes) const override;
+
+	Float area() const;
+
+private:
+	const int* vertices() const;
+
+	const TriangleMesh* m_mesh;
+	int m_triNumber;
+};
+
+//Note: positions, normals, uvs and indices are stored in contiguous arrays and are
+//      transformed to world space once at construction. Emissive surfaces still go
+//      through TriangleShape since an AreaLight needs a Shape to sample.
+class TriangleMesh final
+{
+public:
+	typedef std::shared_ptr<TriangleMesh> ptr;
+
+	TriangleMesh(const Transform& objectToWorld, int nTriangles, const int* indices,
+		int nVertices, const Vector3f* P, const Vector3f* N, const Vector2f* UV,
+		const Material::ptr& material);
+	//Note: borrows the arrays instead of copying them, they must stay valid as long as
+	//      _storage_ is alive (e.g. a memory mapped mesh cache). Positions and normals
+	//      are only copied when _objectToWorld_ is not the identity.
+	TriangleMesh(const Transform& objectToWorld, int nTriangles, const int* indices,
+		int nVertices, const Vector3f* P, const Vector3f* N, const Vector2f* UV,
+		const Material::ptr& material, std::shared_ptr<const void> storage);
+	TriangleMesh(const TriangleMesh&) = delete;
+	TriangleMesh& operator=(const TriangleMesh&) = delete;
+
+	int getTriangleCount() const { return m_nTriangles; }
+	int getVertexCount() const { return m_nVertices; }
+
+	// Appends one hitable per triangle. The triangles are built once with the mesh and
+	// the returned pointers share its reference count, nothing is allocated per triangle.
+	// Calling it again hands out the same triangles. Callers appending several meshes
+	// reserve _hitables_ for all of them up front.
+	static void createTriangles(const TriangleMesh::ptr& mesh, std::vector<Hitable::ptr>& hitables);
+
+public:
+	const int m_nTriangles, m_nVertices;
+	const int* m_indices = nullptr;
+	const Vector3f* m_p = nullptr;
+	const Vector3f* m_n = nullptr;		//nullptr -> no shading normals
+	const Vector2f* m_uv = nullptr;		//nullptr -> default parameterization
+	Material::ptr m_material;
+
+private:
+	void transformVertices(const Transform& objectToWorld, const Vector3f* P, const Vector3f* N);
+	void buildTriangles();
+
+	//Note: never resized after construction, createTriangles() hands out pointers into it.
+	std::vector<Triangle> m_triangles;
+
+	std::vector<int> m_indexBuffer;
+	std::vector<Vector3f> m_pBuffer;
+	std::vector<Vector3f> m_nBuffer;
+	std::vector<Vector2f> m_uvBuffer;
+	std::shared_ptr<const void> m_storage;
+};
+
+RENDER_END
\ No newline at end of file
@@ -0,0 +1,579 @@
+#include "WavefrontIntegrator.h"
+
+#include "BSDF.h"
+#include "Scene.h"
+#include "Light.h"
+#include "../Tool/Parallel.h"
+#include "../Tool/Reporter.h"
+
+#include <tbb/tbb/parallel_scan.h>
+#include <tbb/tbb/parallel_sort.h>
+
+RENDER_BEGIN
+
+//Note: grain of the stage loops, a path costs too little to be scheduled on its own
+static CONSTEXPR size_t StageGrainSize = 64;
+
+template <typename Function>
+static void forEachPath(const std::vector<int>& queue, const Function& func)
+{
+	parallelFor((size_t)0, queue.size(), StageGrainSize, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t i = range.begin(); i != range.end(); ++i)
+				func(queue[i]);
+		});
+}
+
+//Note: the path index overflows an int for large images at high spp, so it is hashed
+//      (64 bit finalizer of MurmurHash3) down to a non-negative seed instead.
+static int pathSeed(int64_t pathIndex)
+{
+	uint64_t v = (uint64_t)pathIndex;
+	v ^= v >> 33;
+	v *= 0xff51afd7ed558ccdULL;
+	v ^= v >> 33;
+	v *= 0xc4ceb9fe1a85ec53ULL;
+	v ^= v >> 33;
+	return (int)(v & 0x7fffffff);
+}
+
+WavefrontPathIntegrator::WavefrontPathIntegrator(int maxDepth, Camera::ptr camera, Sampler::ptr sampler,
+	const Bounds2i& pixelBounds, Float rrThreshold, int waveSize)
+	: PathIntegrator(maxDepth, camera, sampler, pixelBounds, rrThreshold), m_waveSize(waveSize)
+{
+	CHECK_GE(waveSize, 1);
+}
+
+void WavefrontPathIntegrator::PathStates::resize(size_t nPaths)
+{
+	pixel.resize(nPaths);
+	cameraSample.resize(nPaths);
+	rayWeight.resize(nPaths);
+	ray.resize(nPaths);
+	isect.resize(nPaths);
+	L.resize(nPaths);
+	beta.resize(nPaths);
+	bounces.resize(nPaths);
+	specularBounce.resize(nPaths);
+	foundIntersection.resize(nPaths);
+	alive.resize(nPaths);
+
+	hasDirect.resize(nPaths);
+	light.resize(nPaths);
+	lightSelectPdf.resize(nPaths);
+	directBeta.resize(nPaths);
+	hasShadowRay.resize(nPaths);
+	unoccluded.resize(nPaths);
+	shadowRay.resize(nPaths);
+	ldLight.resize(nPaths);
+	hasLightRay.resize(nPaths);
+	lightRay.resize(nPaths);
+	bsdfF.resize(nPaths);
+	lightLe.resize(nPaths);
+	misWeight.resize(nPaths);
+	scatteringPdf.resize(nPaths);
+}
+
+void WavefrontPathIntegrator::compact(const std::vector<int>& queue, const std::vector<uint8_t>& flags,
+	std::vector<int>& out)
+{
+	// A prefix sum over the flags gives every kept path its slot in _out_
+	out.resize(queue.size());
+	size_t nKept = tbb::parallel_scan(tbb::blocked_range<size_t>(0, queue.size(), StageGrainSize), (size_t)0,
+		[&](const tbb::blocked_range<size_t>& range, size_t nBefore, bool isFinalScan) -> size_t
+		{
+			for (size_t i = range.begin(); i != range.end(); ++i)
+			{
+				if (!flags[queue[i]])
+					continue;
+				if (isFinalScan)
+					out[nBefore] = queue[i];
+				++nBefore;
+			}
+			return nBefore;
+		},
+		[](size_t left, size_t right) { return left + right; });
+	out.resize(nKept);
+}
+
+void WavefrontPathIntegrator::render(const Scene& scene)
+{
+	const Film::ptr& film = m_camera->m_film;
+	const int64_t spp = m_sampler->samplesPerPixel;
+
+	// Compute number of tiles, _nTiles_, the waves are cut from the tile sequence
+	Bounds2i sampleBounds = film->getSampleBounds();
+	Vector2i sampleExtent = sampleBounds.diagonal();
+	const int tileSize = m_tileSize;
+	Vector2i nTiles((sampleExtent.x + tileSize - 1) / tileSize, (sampleExtent.y + tileSize - 1) / tileSize);
+	const std::vector<int> tileOrder = computeTileOrder(nTiles, m_tileOrder);
+
+	auto getTileBounds = [&](int t) -> Bounds2i
+	{
+		Vector2i tile(t % nTiles.x, t / nTiles.x);
+		int x0 = sampleBounds.m_pMin.x + tile.x * tileSize;
+		int x1 = glm::min(x0 + tileSize, sampleBounds.m_pMax.x);
+		int y0 = sampleBounds.m_pMin.y + tile.y * tileSize;
+		int y1 = glm::min(y0 + tileSize, sampleBounds.m_pMax.y);
+		return Bounds2i(Vector2i(x0, y0), Vector2i(x1, y1));
+	};
+
+	// Cut the tiles into chunks of at most _m_waveSize_ paths, into bands of rows or, when a
+	// single row is too long, into runs of pixels of a row. Only a pixel that takes more than
+	// _m_waveSize_ samples makes a larger chunk, so a wave holds max(waveSize, spp) paths at most.
+	std::vector<Bounds2i> chunks;
+	std::vector<int> chunkTilesDone;
+	const int64_t chunkPixels = glm::max((int64_t)m_waveSize / spp, (int64_t)1);
+	for (int t : tileOrder)
+	{
+		Bounds2i tileBounds = getTileBounds(t);
+		Vector2i extent = tileBounds.diagonal();
+		if (chunkPixels >= extent.x)
+		{
+			int chunkRows = (int)glm::min(chunkPixels / extent.x, (int64_t)extent.y);
+			for (int y0 = tileBounds.m_pMin.y; y0 < tileBounds.m_pMax.y; y0 += chunkRows)
+			{
+				int y1 = glm::min(y0 + chunkRows, tileBounds.m_pMax.y);
+				chunks.push_back(Bounds2i(Vector2i(tileBounds.m_pMin.x, y0), Vector2i(tileBounds.m_pMax.x, y1)));
+				chunkTilesDone.push_back(0);
+			}
+		}
+		else
+		{
+			for (int y = tileBounds.m_pMin.y; y < tileBounds.m_pMax.y; ++y)
+			{
+				for (int x0 = tileBounds.m_pMin.x; x0 < tileBounds.m_pMax.x; x0 += (int)chunkPixels)
+				{
+					int x1 = glm::min(x0 + (int)chunkPixels, tileBounds.m_pMax.x);
+					chunks.push_back(Bounds2i(Vector2i(x0, y), Vector2i(x1, y + 1)));
+					chunkTilesDone.push_back(0);
+				}
+			}
+		}
+		chunkTilesDone.back() = 1;
+	}
+	const int64_t maxWavePaths = glm::max((int64_t)m_waveSize, spp);
+
+	auto startTime = std::chrono::steady_clock::now();
+	scene.resetRayCount();
+
+	Reporter reporter(nTiles.x * nTiles.y, "Rendering");
+	std::vector<Bounds2i> waveTiles;
+	std::vector<size_t> tileOffsets;
+	std::vector<int> wavePaths, active, shadeQueue, sortedQueue, shadowQueue, lightQueue;
+	int nWaves = 0;
+	int64_t maxBounces = 0;
+	for (size_t nextChunk = 0; nextChunk < chunks.size(); ++nWaves)
+	{
+		// Take chunks until the wave is full, a chunk's paths are laid out pixel by pixel
+		waveTiles.clear();
+		tileOffsets.assign(1, 0);
+		int nTilesDone = 0;
+		while (nextChunk < chunks.size())
+		{
+			size_t nPixels = 0;
+			for (Vector2i pixel : chunks[nextChunk])
+				nPixels += insideExclusive(pixel, m_pixelBounds);
+			size_t nPaths = tileOffsets.back() + nPixels * spp;
+			if (!waveTiles.empty() && nPaths > (size_t)m_waveSize)
+				break;
+			waveTiles.push_back(chunks[nextChunk]);
+			tileOffsets.push_back(nPaths);
+			nTilesDone += chunkTilesDone[nextChunk];
+			++nextChunk;
+		}
+
+		generateCameraRays(waveTiles, tileOffsets, spp);
+
+		// Paths whose camera ray carries no weight never start
+		wavePaths.resize(tileOffsets.back());
+		parallelFor((size_t)0, wavePaths.size(), StageGrainSize, [&](const tbb::blocked_range<size_t>& range)
+			{
+				for (size_t i = range.begin(); i != range.end(); ++i)
+					wavePaths[i] = (int)i;
+			});
+		compact(wavePaths, m_paths.alive, active);
+
+		// Advance all paths of the wave by one bounce per iteration
+		for (int64_t iteration = 0; !active.empty(); ++iteration)
+		{
+			traceClosest(scene, active);
+			addEmission(scene, active);
+			compact(active, m_paths.alive, shadeQueue);
+
+			sortedQueue = shadeQueue;
+			sortByMaterial(sortedQueue);
+			shade(scene, sortedQueue);
+
+			compact(shadeQueue, m_paths.hasShadowRay, shadowQueue);
+			traceShadowRays(scene, shadowQueue);
+			compact(shadeQueue, m_paths.hasLightRay, lightQueue);
+			traceLightRays(scene, lightQueue);
+			accumulateDirect(shadeQueue);
+
+			compact(shadeQueue, m_paths.alive, active);
+			maxBounces = glm::max(maxBounces, iteration + 1);
+		}
+
+		addSamples(waveTiles, tileOffsets);
+		reporter.update(nTilesDone);
+	}
+	reporter.done();
+
+	m_camera->m_film->mergeSplats();
+	K_INFO("Rendering finished");
+
+	Float elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		std::chrono::steady_clock::now() - startTime).count();
+	int64_t nRays = scene.getRayCount();
+	K_INFO(stringPrintf("Traced %lld rays in %.0f ms (%.2f M rays/s)",
+		(long long)nRays, elapsed, elapsed > 0 ? nRays / (elapsed * 1000.f) : 0.f));
+	K_INFO(stringPrintf("Wavefront: %d waves of up to %lld paths, %lld bounce iterations at most",
+		nWaves, (long long)maxWavePaths, (long long)maxBounces));
+
+	m_camera->m_film->writeImageToFile();
+}
+
+void WavefrontPathIntegrator::generateCameraRays(const std::vector<Bounds2i>& waveTiles,
+	const std::vector<size_t>& tileOffsets, int64_t spp)
+{
+	const size_t nPaths = tileOffsets.back();
+	m_paths.resize(nPaths);
+	while (m_paths.sampler.size() < nPaths)
+		m_paths.sampler.push_back(m_sampler->clone(0));
+
+	const Bounds2i sampleBounds = m_camera->m_film->getSampleBounds();
+	const int sampleWidth = sampleBounds.diagonal().x;
+	parallelFor((size_t)0, waveTiles.size(), (size_t)1, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t t = range.begin(); t != range.end(); ++t)
+			{
+				size_t index = tileOffsets[t];
+				for (Vector2i pixel : waveTiles[t])
+				{
+					if (!insideExclusive(pixel, m_pixelBounds))
+						continue;
+					for (int64_t s = 0; s < spp; ++s, ++index)
+					{
+						//Note: the path's sampler is put into the state the tile sampler of the
+						//      PathIntegrator has when it starts sample _s_ of _pixel_.
+						Sampler& sampler = *m_paths.sampler[index];
+						int64_t pixelIndex = (int64_t)(pixel.y - sampleBounds.m_pMin.y) * sampleWidth +
+							(pixel.x - sampleBounds.m_pMin.x);
+						sampler.reseed(pathSeed(pixelIndex * spp + s));
+						sampler.startPixel(pixel);
+						if (s > 0)
+							sampler.setSampleNumber(s);
+
+						m_paths.pixel[index] = pixel;
+						m_paths.cameraSample[index] = sampler.getCameraSample(pixel);
+						m_paths.ray[index] = Ray();
+						m_paths.rayWeight[index] = m_camera->castingRay(m_paths.cameraSample[index], m_paths.ray[index]);
+						m_paths.alive[index] = m_paths.rayWeight[index] > 0;
+						m_paths.L[index] = Spectrum(0.f);
+						m_paths.beta[index] = Spectrum(1.f);
+						m_paths.bounces[index] = 0;
+						m_paths.specularBounce[index] = false;
+					}
+				}
+			}
+		});
+}
+
+void WavefrontPathIntegrator::traceClosest(const Scene& scene, const std::vector<int>& queue)
+{
+	forEachPath(queue, [&](int i)
+		{
+			m_paths.foundIntersection[i] = scene.hit(m_paths.ray[i], m_paths.isect[i]);
+		});
+}
+
+void WavefrontPathIntegrator::addEmission(const Scene& scene, const std::vector<int>& queue)
+{
+	forEachPath(queue, [&](int i)
+		{
+			const Ray& ray = m_paths.ray[i];
+			bool foundIntersection = m_paths.foundIntersection[i];
+
+			// Possibly add emitted light at intersection
+			if (m_paths.bounces[i] == 0 || m_paths.specularBounce[i])
+			{
+				if (foundIntersection)
+				{
+					m_paths.L[i] += m_paths.beta[i] * m_paths.isect[i].Le(-ray.direction());
+				}
+				else
+				{
+					for (const auto& light : scene.m_infiniteLights)
+						m_paths.L[i] += m_paths.beta[i] * light->Le(ray);
+				}
+			}
+
+			// Terminate path if ray escaped or _maxDepth_ was reached
+			m_paths.alive[i] = foundIntersection && m_paths.bounces[i] < m_maxDepth;
+		});
+}
+
+void WavefrontPathIntegrator::sortByMaterial(std::vector<int>& queue)
+{
+	// Look the materials up once instead of in every comparison
+	m_sortKeys.resize(queue.size());
+	parallelFor((size_t)0, queue.size(), StageGrainSize, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t i = range.begin(); i != range.end(); ++i)
+			{
+				const Material* material = m_paths.isect[queue[i]].hitable->getMaterial();
+				m_sortKeys[i] = std::make_pair((uintptr_t)material, queue[i]);
+			}
+		});
+
+	//Note: ties keep the path order, the paths of a material stay spatially coherent
+	tbb::parallel_sort(m_sortKeys.begin(), m_sortKeys.end());
+	parallelFor((size_t)0, queue.size(), StageGrainSize, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t i = range.begin(); i != range.end(); ++i)
+				queue[i] = m_sortKeys[i].second;
+		});
+}
+
+void WavefrontPathIntegrator::shade(const Scene& scene, const std::vector<int>& queue)
+{
+	//Note: mirrors one iteration of PathIntegrator::tracePath() after the intersection, the
+	//      sampler dimensions are drawn in the same order. Visibility and the hit of the
+	//      BSDF sampled light ray are left to the trace stages.
+	forEachPath(queue, [&](int i)
+		{
+			MemoryArena& arena = m_arenas.local();
+			Sampler& sampler = *m_paths.sampler[i];
+			SurfaceInteraction& isect = m_paths.isect[i];
+			Ray& ray = m_paths.ray[i];
+			Spectrum& beta = m_paths.beta[i];
+
+			m_paths.hasDirect[i] = false;
+			m_paths.hasShadowRay[i] = false;
+			m_paths.hasLightRay[i] = false;
+
+			// Compute scattering functions and skip over medium boundaries
+			isect.computeScatteringFunctions(ray, arena, true);
+			if (!isect.bsdf)
+			{
+				ray = isect.spawnRay(ray.direction());
+				arena.Reset();
+				return;
+			}
+			const BSDF& bsdf = *isect.bsdf;
+
+			// Sample one light as uniformSampleOneLight() and estimateDirect() do
+			int nLights = int(scene.m_lights.size());
+			if (bsdf.numComponents(BxDFType(BSDF_ALL & ~BSDF_SPECULAR)) > 0 && nLights > 0)
+			{
+				int lightNum;
+				Float lightPdf;
+				if (m_lightDistrib != nullptr)
+					lightNum = m_lightDistrib->sampleDiscrete(sampler.get1D(), &lightPdf);
+				else
+				{
+					lightNum = glm::min((int)(sampler.get1D() * nLights), nLights - 1);
+					lightPdf = Float(1) / nLights;
+				}
+
+				if (lightPdf > 0)
+				{
+					const Light& light = *scene.m_lights[lightNum];
+					Vector2f uLight = sampler.get2D();
+					Vector2f uScattering = sampler.get2D();
+					const BxDFType bsdfFlags = BxDFType(BSDF_ALL & ~BSDF_SPECULAR);
+
+					m_paths.hasDirect[i] = true;
+					m_paths.light[i] = &light;
+					m_paths.lightSelectPdf[i] = lightPdf;
+					m_paths.directBeta[i] = beta;
+					m_paths.ldLight[i] = Spectrum(0.f);
+
+					// Light sampling, the shadow ray decides about the contribution
+					Vector3f wi;
+					Float lightSamplePdf = 0, scatteringPdf = 0;
+					VisibilityTester visibility;
+					Spectrum Li = light.sample_Li(isect, uLight, wi, lightSamplePdf, visibility);
+					if (lightSamplePdf > 0 && !Li.isBlack())
+					{
+						Spectrum f = bsdf.f(isect.wo, wi, bsdfFlags) * absDot(wi, isect.normal);
+						scatteringPdf = bsdf.pdf(isect.wo, wi, bsdfFlags);
+						if (!f.isBlack())
+						{
+							m_paths.hasShadowRay[i] = true;
+							m_paths.shadowRay[i] = visibility.P0().spawnRayTo(visibility.P1());
+							if (isDeltaLight(light.flags))
+								m_paths.ldLight[i] = f * Li / lightSamplePdf;
+							else
+							{
+								Float weight = powerHeuristic(1, lightSamplePdf, 1, scatteringPdf);
+								m_paths.ldLight[i] = f * Li * weight / lightSamplePdf;
+							}
+						}
+					}
+
+					// BSDF sampling, the light ray finds out whether the light is seen
+					if (!isDeltaLight(light.flags))
+					{
+						BxDFType sampledType = BxDFType::BSDF_ALL;
+						Spectrum f = bsdf.sample_f(isect.wo, wi, uScattering, scatteringPdf, sampledType, bsdfFlags);
+						f *= absDot(wi, isect.normal);
+						bool sampledSpecular = (sampledType & BSDF_SPECULAR) != 0;
+						if (!f.isBlack() && scatteringPdf > 0)
+						{
+							Float weight = 1;
+							if (!sampledSpecular)
+							{
+								lightSamplePdf = light.pdf_Li(isect, wi);
+								weight = powerHeuristic(1, scatteringPdf, 1, lightSamplePdf);
+							}
+							if (sampledSpecular || lightSamplePdf != 0)
+							{
+								m_paths.hasLightRay[i] = true;
+								m_paths.lightRay[i] = isect.spawnRay(wi);
+								m_paths.bsdfF[i] = f;
+								m_paths.misWeight[i] = weight;
+								m_paths.scatteringPdf[i] = scatteringPdf;
+							}
+						}
+					}
+				}
+			}
+
+			// Sample BSDF to get new path direction
+			m_paths.alive[i] = false;
+			Vector3f wo = -ray.direction(), wi;
+			Float pdf = 0;
+			BxDFType flags = BSDF_ALL;
+			Spectrum f = bsdf.sample_f(wo, wi, sampler.get2D(), pdf, flags, BSDF_ALL);
+			if (!f.isBlack() && pdf != 0.f)
+			{
+				beta *= f * absDot(wi, isect.normal) / pdf;
+				DCHECK(!glm::isinf(beta.y()));
+				m_paths.specularBounce[i] = (flags & BSDF_SPECULAR) != 0;
+				ray = isect.spawnRay(wi);
+				m_paths.alive[i] = true;
+
+				// Possibly terminate the path with Russian roulette
+				Float maxBeta = beta.maxComponentValue();
+				if (maxBeta < m_rrThreshold && m_paths.bounces[i] > 3)
+				{
+					Float q = glm::max((Float).05, 1 - maxBeta);
+					if (sampler.get1D() < q)
+						m_paths.alive[i] = false;
+					else
+					{
+						beta /= 1 - q;
+						DCHECK(!glm::isinf(beta.y()));
+					}
+				}
+				m_paths.bounces[i] += m_paths.alive[i];
+			}
+
+			arena.Reset();
+		});
+}
+
+void WavefrontPathIntegrator::traceShadowRays(const Scene& scene, const std::vector<int>& queue)
+{
+	// Gather the shadow rays into one batch for the packet any-hit traversal
+	m_shadowBatch.resize(queue.size());
+	parallelFor((size_t)0, queue.size(), StageGrainSize, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t k = range.begin(); k != range.end(); ++k)
+				m_shadowBatch[k] = m_paths.shadowRay[queue[k]];
+		});
+
+	scene.occluded(m_shadowBatch.data(), m_shadowBatch.size(), m_shadowOccluded);
+	parallelFor((size_t)0, queue.size(), StageGrainSize, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t k = range.begin(); k != range.end(); ++k)
+				m_paths.unoccluded[queue[k]] = !m_shadowOccluded[k];
+		});
+}
+
+void WavefrontPathIntegrator::traceLightRays(const Scene& scene, const std::vector<int>& queue)
+{
+	//Note: the vertex was shaded already, its interaction is reused for the light ray's hit
+	forEachPath(queue, [&](int i)
+		{
+			const Ray& ray = m_paths.lightRay[i];
+			SurfaceInteraction& lightIsect = m_paths.isect[i];
+			const Light& light = *m_paths.light[i];
+			m_paths.lightLe[i] = Spectrum(0.f);
+			if (scene.hit(ray, lightIsect))
+			{
+				if (lightIsect.hitable->getAreaLight() == &light)
+					m_paths.lightLe[i] = lightIsect.Le(-ray.direction());
+			}
+			else
+			{
+				m_paths.lightLe[i] = light.Le(ray);
+			}
+		});
+}
+
+void WavefrontPathIntegrator::accumulateDirect(const std::vector<int>& queue)
+{
+	forEachPath(queue, [&](int i)
+		{
+			if (!m_paths.hasDirect[i])
+				return;
+
+			// Same sum as estimateDirect() and uniformSampleOneLight()
+			Spectrum Ld(0.f);
+			if (m_paths.hasShadowRay[i] && m_paths.unoccluded[i])
+				Ld += m_paths.ldLight[i];
+			if (m_paths.hasLightRay[i] && !m_paths.lightLe[i].isBlack())
+				Ld += m_paths.bsdfF[i] * m_paths.lightLe[i] * m_paths.misWeight[i] / m_paths.scatteringPdf[i];
+
+			Ld = m_paths.directBeta[i] * (Ld / m_paths.lightSelectPdf[i]);
+			CHECK_GE(Ld.y(), 0.f);
+			m_paths.L[i] += Ld;
+		});
+}
+
+void WavefrontPathIntegrator::addSamples(const std::vector<Bounds2i>& waveTiles, const std::vector<size_t>& tileOffsets)
+{
+	const Film::ptr& film = m_camera->m_film;
+	while (m_filmTiles.size() < waveTiles.size())
+		m_filmTiles.push_back(nullptr);
+
+	// Every tile adds its samples in the order the PathIntegrator adds them
+	parallelFor((size_t)0, waveTiles.size(), (size_t)1, [&](const tbb::blocked_range<size_t>& range)
+		{
+			for (size_t t = range.begin(); t != range.end(); ++t)
+			{
+				std::unique_ptr<FilmTile>& filmTile = m_filmTiles[t];
+				if (filmTile == nullptr)
+				{
+					filmTile = film->getFilmTile(waveTiles[t]);
+					filmTile->reserve(m_tileSize);
+				}
+				else
+					film->resetFilmTile(*filmTile, waveTiles[t]);
+
+				for (size_t i = tileOffsets[t]; i < tileOffsets[t + 1]; ++i)
+				{
+					const Vector2i& pixel = m_paths.pixel[i];
+					Spectrum L = m_paths.L[i];
+
+					// Issue warning if unexpected radiance value returned
+					if (L.hasNaNs() || L.y() < -1e-5 || std::isinf(L.y()))
+					{
+						K_ERROR(stringPrintf(
+							"Invalid radiance value returned for pixel (%d, %d), sample %d. Setting to black.",
+							pixel.x, pixel.y, (int)m_paths.sampler[i]->currentSampleNumber()));
+						L = Spectrum(0.f);
+					}
+
+					filmTile->addSample(m_paths.cameraSample[i].pFilm, L, m_paths.rayWeight[i]);
+					filmTile->addPixelStatistics(pixel, L, m_paths.rayWeight[i]);
+				}
+				film->mergeFilmTile(*filmTile);
+			}
+		});
+}
+
+RENDER_END
\ No newline at end of file
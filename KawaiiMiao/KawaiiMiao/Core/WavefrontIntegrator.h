@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Rendering.h"
+#include "PathIntegrator.h"
+#include "Interaction.h"
+#include "Scene.h"
+#include "../Tool/Memory.h"
+
+#include <tbb/tbb/enumerable_thread_specific.h>
+
+RENDER_BEGIN
+
+//Note: wavefront formulation of the path tracer. A wave keeps the paths of a run of tiles
+//      (split when a tile exceeds the wave size) in flight and advances all of them one
+//      bounce at a time through separate stages
+//      (generate, intersect, sort by material, shade, shadow trace, accumulate), each a
+//      parallel loop over a queue of path indices. Every path owns a sampler clone started
+//      at its pixel and sample, the deterministic samplers therefore give the same samples
+//      and the same image as the PathIntegrator; the random sampler is seeded per sample.
+//      Adaptive sampling, progressive rendering and ray packets are not supported.
+class WavefrontPathIntegrator : public PathIntegrator
+{
+public:
+	typedef std::shared_ptr<WavefrontPathIntegrator> ptr;
+
+	WavefrontPathIntegrator(int maxDepth, Camera::ptr camera, Sampler::ptr sampler,
+		const Bounds2i& pixelBounds, Float rrThreshold = 1, int waveSize = 1 << 16);
+
+	virtual void render(const Scene& scene) override;
+
+private:
+	//Note: path state in structure of arrays layout, indexed by the path's slot in the wave.
+	//      The direct lighting of a vertex is kept pending until its shadow ray and the ray
+	//      of the BSDF sampling strategy are traced.
+	struct PathStates
+	{
+		void resize(size_t nPaths);
+
+		std::vector<Vector2i> pixel;
+		std::vector<CameraSample> cameraSample;
+		std::vector<Float> rayWeight;
+		std::vector<std::unique_ptr<Sampler>> sampler;
+
+		std::vector<Ray> ray;
+		std::vector<SurfaceInteraction> isect;
+		std::vector<Spectrum> L, beta;
+		std::vector<int> bounces;
+		std::vector<uint8_t> specularBounce;
+		std::vector<uint8_t> foundIntersection;
+		std::vector<uint8_t> alive;
+
+		// Pending direct lighting of the vertex, see accumulateDirect()
+		std::vector<uint8_t> hasDirect;
+		std::vector<const Light*> light;
+		std::vector<Float> lightSelectPdf;
+		std::vector<Spectrum> directBeta;
+		std::vector<uint8_t> hasShadowRay, unoccluded;
+		std::vector<Ray> shadowRay;
+		std::vector<Spectrum> ldLight;
+		std::vector<uint8_t> hasLightRay;
+		std::vector<Ray> lightRay;
+		std::vector<Spectrum> bsdfF, lightLe;
+		std::vector<Float> misWeight, scatteringPdf;
+	};
+
+	void generateCameraRays(const std::vector<Bounds2i>& waveTiles, const std::vector<size_t>& tileOffsets,
+		int64_t spp);
+	void traceClosest(const Scene& scene, const std::vector<int>& queue);
+	void addEmission(const Scene& scene, const std::vector<int>& queue);
+	void sortByMaterial(std::vector<int>& queue);
+	void shade(const Scene& scene, const std::vector<int>& queue);
+	void traceShadowRays(const Scene& scene, const std::vector<int>& queue);
+	void traceLightRays(const Scene& scene, const std::vector<int>& queue);
+	void accumulateDirect(const std::vector<int>& queue);
+	void addSamples(const std::vector<Bounds2i>& waveTiles, const std::vector<size_t>& tileOffsets);
+
+	// Indices of _queue_ with nonzero _flags_, in the order of _queue_
+	static void compact(const std::vector<int>& queue, const std::vector<uint8_t>& flags, std::vector<int>& out);
+
+	const int m_waveSize;
+	PathStates m_paths;
+	std::vector<std::pair<uintptr_t, int>> m_sortKeys;
+	std::vector<Ray> m_shadowBatch;
+	RayBitset m_shadowOccluded;
+	std::vector<std::unique_ptr<FilmTile>> m_filmTiles;
+	tbb::enumerable_thread_specific<MemoryArena> m_arenas;
+};
+
+RENDER_END
\ No newline at end of file
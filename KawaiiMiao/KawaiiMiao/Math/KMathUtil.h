@@ -13,6 +13,14 @@ inline bool isNaN(const T x) { return std::isnan(x); }
 template <>
 inline bool isNaN(const int x) { return false; }
 
+// Remainder that takes the sign of _b_, e.g. mod(-1, 4) -> 3
+template <typename T>
+inline T mod(T a, T b)
+{
+	T result = a - (a / b) * b;
+	return (T)((result < 0) ? result + b : result);
+}
+
 // Vector
 template<typename T>
 using Vector2 = glm::vec<2, T>;
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../Core/Rendering.h"
+#include "Rng.h"
+
+#include <vector>
+
+RENDER_BEGIN
+
+// Low Discrepancy Declarations
+static CONSTEXPR int PrimeTableSize = 1000;
+extern const int Primes[PrimeTableSize];
+//Note: PrimeSums[i] is the sum of the first i primes, the offset of the permutation of
+//      the i-th prime base in the array computeRadicalInversePermutations() returns.
+extern const int PrimeSums[PrimeTableSize];
+
+// Radical inverse of _a_ in the base of the prime Primes[_baseIndex_]
+Float radicalInverse(int baseIndex, uint64_t a);
+Float scrambledRadicalInverse(int baseIndex, uint64_t a, const uint16_t* perm);
+
+// One random digit permutation per prime base, concatenated
+std::vector<uint16_t> computeRadicalInversePermutations(Rng& rng);
+
+// Index whose first _nDigits_ base _base_ digits reversed are _inverse_
+template <int base>
+inline uint64_t inverseRadicalInverse(uint64_t inverse, int nDigits)
+{
+	uint64_t index = 0;
+	for (int i = 0; i < nDigits; ++i)
+	{
+		uint64_t digit = inverse % base;
+		inverse /= base;
+		index = index * base + digit;
+	}
+	return index;
+}
+
+inline uint32_t reverseBits32(uint32_t n)
+{
+	n = (n << 16) | (n >> 16);
+	n = ((n & 0x00ff00ff) << 8) | ((n & 0xff00ff00) >> 8);
+	n = ((n & 0x0f0f0f0f) << 4) | ((n & 0xf0f0f0f0) >> 4);
+	n = ((n & 0x33333333) << 2) | ((n & 0xcccccccc) >> 2);
+	n = ((n & 0x55555555) << 1) | ((n & 0xaaaaaaaa) >> 1);
+	return n;
+}
+
+inline uint64_t reverseBits64(uint64_t n)
+{
+	uint64_t n0 = reverseBits32((uint32_t)n);
+	uint64_t n1 = reverseBits32((uint32_t)(n >> 32));
+	return (n0 << 32) | n1;
+}
+
+//Note: the first two dimensions of the Sobol' sequence form a (0,2)-sequence in base 2,
+//      every power of two long run of it is stratified in all elementary intervals. The
+//      generator matrix of dimension 0 is the identity, that of dimension 1 follows from
+//      the primitive polynomial x + 1.
+inline uint32_t sobolSample2(uint32_t a, int dimension)
+{
+	if (dimension == 0)
+		return reverseBits32(a);
+
+	uint32_t v = 0;
+	for (uint32_t c = 1u << 31; a != 0; a >>= 1, c ^= c >> 1)
+		if (a & 1)
+			v ^= c;
+	return v;
+}
+
+//Note: Laine-Karras style hash that scrambles each bit by the bits below it only, applied to
+//      bit reversed values it performs a nested uniform (Owen) scramble and keeps the
+//      stratification of the (0,2)-sequence intact.
+inline uint32_t laineKarrasPermutation(uint32_t x, uint32_t seed)
+{
+	x += seed;
+	x ^= x * 0x6c50b47cu;
+	x ^= x * 0xb82f1e52u;
+	x ^= x * 0xc7afe638u;
+	x ^= x * 0x8d22f6e6u;
+	return x;
+}
+
+inline uint32_t nestedUniformScramble(uint32_t x, uint32_t seed)
+{
+	return reverseBits32(laineKarrasPermutation(reverseBits32(x), seed));
+}
+
+inline Float bitsToUnitFloat(uint32_t v)
+{
+	return glm::min(Float(v * 2.3283064365386963e-10f), aOneMinusEpsilon);
+}
+
+RENDER_END
\ No newline at end of file
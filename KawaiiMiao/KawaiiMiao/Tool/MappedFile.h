@@ -0,0 +1,38 @@
+#pragma once
+
+#include "../Core/Rendering.h"
+
+#include <string>
+
+RENDER_BEGIN
+
+//Note: read-only view of a whole file mapped into the address space. Pages are loaded
+//      lazily by the OS, so opening even a multi-GB file is nearly free.
+class MappedFile
+{
+public:
+	typedef std::shared_ptr<MappedFile> ptr;
+
+	MappedFile() = default;
+	~MappedFile();
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	bool open(const std::string& path);
+	void close();
+
+	bool isOpen() const { return m_data != nullptr; }
+	const char* data() const { return m_data; }
+	size_t size() const { return m_size; }
+
+private:
+	const char* m_data = nullptr;
+	size_t m_size = 0;
+#if defined(_WIN32)
+	void* m_file = nullptr;
+	void* m_mapping = nullptr;
+#endif
+};
+
+RENDER_END
\ No newline at end of file
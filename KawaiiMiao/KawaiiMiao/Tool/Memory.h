@@ -1,5 +1,5 @@
 #ifndef RMEMORY_H
-#define MEMORY_H
+#define RMEMORY_H
 
 #include <list>
 #include <algorithm>
@@ -2,16 +2,49 @@
 #include "Core/Light.h"
 #include "Core/Shape.h"
 #include "Core/Primitive.h"
+#include "Core/BVH.h"
 #include "Core/Material.h"
 #include "Core/Integrator.h"
+#include "Core/SceneParser.h"
+
+#ifndef _WIN32
+#include <csignal>
+#endif
 
 using namespace Render;
 using namespace std;
 
-int main()
+#ifndef _WIN32
+//Note: SIGUSR1 asks a progressive render for a snapshot of the current image
+static SamplerIntegrator* snapshotIntegrator = nullptr;
+static void requestSnapshot(int) { snapshotIntegrator->requestSnapshot(); }
+#endif
+
+int main(int argc, char* argv[])
 {
 	Render::Log::Init();
 
+	//Note: a json scene file on the command line replaces the built-in Cornell box,
+	//      e.g. KawaiiMiao ../../example/cornellBox.json
+	if (argc > 1)
+	{
+		ParsedScene parsed;
+		if (!SceneParser::parser(argv[1], parsed))
+			return 1;
+
+		printf("Kawaii (built %s at %s) [Detected %d cores]\n",
+			__DATE__, __TIME__, numSystemCores());
+
+#ifndef _WIN32
+		snapshotIntegrator = parsed.integrator.get();
+		signal(SIGUSR1, requestSnapshot);
+#endif
+
+		parsed.integrator->preprocess(*parsed.scene, *parsed.sampler);
+		parsed.integrator->render(*parsed.scene);
+		return 0;
+	}
+
 	Float white[] = { 0.73f, 0.73f, 0.73f };
 	Float green[] = { 0.12f, 0.45f, 0.15f };
 	Float red[] = { 0.65f, 0.05f, 0.05f };
@@ -95,22 +128,12 @@ int main()
 	AreaLight::ptr light2 = std::make_shared<DiffuseAreaLight>(identity, light_unit, 8, lamp2);
 	HitableEntity::ptr entity14 = std::make_shared<HitableEntity>(lamp2, whiteLambert_mat, light2);
 
-	HitableList::ptr aggregate = std::make_shared<HitableList>();
-	aggregate->addHitable(entity1);
-	aggregate->addHitable(entity2);
-	aggregate->addHitable(entity3);
-	aggregate->addHitable(entity4);
-	aggregate->addHitable(entity5);
-	aggregate->addHitable(entity6);
-	aggregate->addHitable(entity7);
-	aggregate->addHitable(entity8);
-	aggregate->addHitable(entity9);
-	aggregate->addHitable(entity10);
-	aggregate->addHitable(entity11);
-	aggregate->addHitable(entity12);
-	aggregate->addHitable(entity13);
-	aggregate->addHitable(entity14);
-	//aggregate->addHitable(entity15);
+	std::vector<Hitable::ptr> hitables =
+	{
+		entity1, entity2, entity3, entity4, entity5, entity6, entity7,
+		entity8, entity9, entity10, entity11, entity12, entity13, entity14
+	};
+	HitableBVH::ptr aggregate = std::make_shared<HitableBVH>(hitables);
 
 	//Scene
 	std::vector<Light::ptr> lights = { light1, light2 };